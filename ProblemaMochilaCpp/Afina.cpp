@@ -0,0 +1,125 @@
+#include <iostream>
+#include <cmath>
+#include <string>
+#include <cstdlib>
+
+#include "Afinador.h"
+#include "CasosPrueba.h"
+#include "Generador.h"
+
+/*
+ * Afina los parametros del algoritmo genetico para una clase de instancias
+ * y guarda la mejor configuracion en un fichero que se puede cargar con
+ * leeConfigGenetico (o con la opcion -g de Benchmark).
+ *
+ * Uso: Afina [-c clase] [-n objetos] [-i instancias] [-k candidatas]
+ *            [-q calidad] [-l tiempoMax] [-t hilos] [-s semilla] fichero
+ *
+ * El objetivo de cada instancia es calidad * el valor optimo, que se
+ * calcula con mochilaProgDinDispersa.
+ */
+
+static const char *const NOMBRES_CLASES[] = {
+        "nocorr", "debil", "fuerte", "inversa", "subconjuntos", "spanner",
+        "techo"
+};
+
+void muestraUso() {
+    std::cout << "Uso: Afina [-c clase] [-n objetos] [-i instancias] "
+                 "[-k candidatas] [-q calidad] [-l tiempoMax] [-t hilos] "
+                 "[-s semilla] fichero\nClases:";
+    for (const char *nombre : NOMBRES_CLASES)
+        std::cout << ' ' << nombre;
+    std::cout << '\n';
+}
+
+/**
+ * Genera en memoria la instancia de la clase dada por paramGen y calcula su
+ * objetivo.
+ */
+void generaInstancia(ParamGenerador const &paramGen, double calidad,
+                     InstanciaAfinado &ins) {
+    ins.objetos.resize(paramGen.nObjetos);
+    double sumaPesos = 0;
+    for (long long i = 0; i < paramGen.nObjetos; ++i) {
+        long long peso, valor;
+        generaObjeto(paramGen, i, peso, valor);
+        ins.objetos[i].peso = (double) peso;
+        ins.objetos[i].valor = (double) valor;
+        sumaPesos += (double) peso;
+    }
+    ins.M = std::floor(paramGen.fraccionM * sumaPesos);
+
+    std::vector<bool> sol(ins.objetos.size());
+    double optimo;
+    mochilaProgDinDispersa(ins.objetos, ins.M, sol, optimo);
+    ins.objetivo = calidad * optimo;
+}
+
+int main(int argc, char *argv[]) {
+    ParamGenerador paramGen;
+    ParamAfinador param;
+    int nInstancias = 16;
+    double calidad = 0.99;
+    std::string fichero;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg[0] == '-' && i + 1 < argc) {
+            std::string valor = argv[++i];
+            if (arg == "-c") {
+                bool encontrada = false;
+                for (int c = 0; c <= TECHO_BENEFICIO; ++c) {
+                    if (valor == NOMBRES_CLASES[c]) {
+                        paramGen.clase = (ClaseInstancia) c;
+                        encontrada = true;
+                    }
+                }
+                if (!encontrada) {
+                    muestraUso();
+                    return 1;
+                }
+            } else if (arg == "-n") {
+                paramGen.nObjetos = std::atoll(valor.c_str());
+            } else if (arg == "-i") {
+                nInstancias = std::atoi(valor.c_str());
+            } else if (arg == "-k") {
+                param.nCandidatos = std::atoi(valor.c_str());
+            } else if (arg == "-q") {
+                calidad = std::atof(valor.c_str());
+            } else if (arg == "-l") {
+                param.tiempoMax = std::atof(valor.c_str());
+            } else if (arg == "-t") {
+                param.nHilos = std::atoi(valor.c_str());
+            } else if (arg == "-s") {
+                param.semilla = (unsigned int) std::atoi(valor.c_str());
+            } else {
+                muestraUso();
+                return 1;
+            }
+        } else if (arg[0] != '-' && fichero.empty()) {
+            fichero = arg;
+        } else {
+            muestraUso();
+            return 1;
+        }
+    }
+    if (fichero.empty() || paramGen.nObjetos < 1 || nInstancias < 1 ||
+        param.nCandidatos < 1 || param.tiempoMax <= 0) {
+        muestraUso();
+        return 1;
+    }
+
+    //Cada instancia de la clase usa una semilla distinta
+    std::vector<InstanciaAfinado> instancias(nInstancias);
+    for (int j = 0; j < nInstancias; ++j) {
+        paramGen.semilla = (unsigned long long) param.semilla * 1000 + j;
+        generaInstancia(paramGen, calidad, instancias[j]);
+    }
+
+    ConfigGenetico mejor;
+    afinaGenetico(instancias, param, mejor);
+    guardaConfigGenetico(fichero, mejor);
+    std::cout << "Mejor configuracion guardada en " << fichero << ".\n";
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include "Afinador.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <thread>
+
+static const double PENALIZACION = 10;
+
+/**
+ * Sortea una configuracion del algoritmo genetico.
+ */
+static ConfigGenetico configAleatoria(std::mt19937 &gen) {
+    auto entero = [&](int a, int b) {
+        return std::uniform_int_distribution<int>(a, b)(gen);
+    };
+    auto real = [&](double a, double b) {
+        return std::uniform_real_distribution<double>(a, b)(gen);
+    };
+    ConfigGenetico config;
+    config.maxGeneraciones = entero(200, 5000);
+    config.tamPobl = entero(20, 300);
+    config.tamUlt = entero(5, 50);
+    config.probMutacion = real(0.01, 0.5);
+    config.porcMutacion = real(0.001, 0.05);
+    config.probCruce = real(0.5, 1);
+    config.probElitismo = real(0.01, 0.3);
+    config.probBusquedaLocal = real(0, 0.2);
+    return config;
+}
+
+/**
+ * Coste de una ejecucion del algoritmo genetico: los segundos que tarda en
+ * alcanzar el objetivo de la instancia o, si no lo alcanza, PENALIZACION
+ * veces el tiempo maximo.
+ *
+ * @param ins Instancia con su objetivo.
+ * @param config Parametros del algoritmo genetico.
+ * @param tiempoMax Segundos maximos de la ejecucion.
+ * @return Coste de la ejecucion en segundos.
+ */
+double costeGenetico(InstanciaAfinado const &ins, ConfigGenetico config,
+                     double tiempoMax) {
+    std::vector<bool> sol(ins.objetos.size());
+    double valor;
+    config.objetivo = ins.objetivo;
+    config.tiempoMax = tiempoMax;
+
+    auto t1 = std::chrono::steady_clock::now();
+    mochilaGenetico(ins.objetos, ins.M, sol, valor, nullptr, config);
+    auto t2 = std::chrono::steady_clock::now();
+
+    if (valor < ins.objetivo)
+        return PENALIZACION * tiempoMax;
+    return std::chrono::duration<double>(t2 - t1).count();
+}
+
+/**
+ * Busca la configuracion del algoritmo genetico que alcanza antes el
+ * objetivo de las instancias. La primera candidata son los parametros por
+ * defecto y el resto se sortean. Las ejecuciones de cada ronda se reparten
+ * entre nHilos hilos y todas las configuraciones usan la misma semilla en
+ * cada instancia. Muestra por pantalla el resultado de cada ronda.
+ *
+ * Coste: O(k log k) ejecuciones, k = numero de candidatas.
+ *
+ * @param instancias Instancias de la clase para la que se afina.
+ * @param param Parametros de la busqueda.
+ * @param mejor Mejor configuracion encontrada.
+ */
+void afinaGenetico(std::vector<InstanciaAfinado> const &instancias,
+                   ParamAfinador const &param, ConfigGenetico &mejor) {
+    int nHilos = param.nHilos;
+    if (nHilos <= 0)
+        nHilos = std::max(1u, std::thread::hardware_concurrency());
+
+    std::mt19937 gen(param.semilla);
+    std::vector<ConfigGenetico> candidatos(std::max(1, param.nCandidatos));
+    for (size_t c = 1; c < candidatos.size(); ++c)
+        candidatos[c] = configAleatoria(gen);
+
+    //Todas las configuraciones usan la misma semilla en cada instancia
+    std::vector<unsigned int> semillas(instancias.size());
+    for (unsigned int &s : semillas)
+        s = gen() | 1;
+
+    std::vector<double> costeAc(candidatos.size(), 0);
+    std::vector<size_t> vivos(candidatos.size());
+    std::iota(vivos.begin(), vivos.end(), 0);
+    size_t evaluadas = 0;   //Instancias en las que ya se han probado los vivos
+    size_t nInst = std::min(instancias.size(),
+                            (size_t) std::max(1, param.instanciasIniciales));
+
+    for (int ronda = 0; !instancias.empty(); ++ronda) {
+        //Repartimos las ejecuciones (candidata, instancia) entre los hilos
+        const size_t m = nInst - evaluadas;
+        const size_t total = vivos.size() * m;
+        std::vector<double> costes(total);
+        std::atomic<size_t> siguiente(0);
+        auto trabaja = [&]() {
+            for (size_t t = siguiente++; t < total; t = siguiente++) {
+                const size_t i = evaluadas + t % m;
+                ConfigGenetico config = candidatos[vivos[t / m]];
+                config.semilla = semillas[i];
+                costes[t] = costeGenetico(instancias[i], config,
+                                          param.tiempoMax);
+            }
+        };
+        std::vector<std::thread> hilos;
+        for (int h = 0; h < nHilos; ++h)
+            hilos.emplace_back(trabaja);
+        for (std::thread &h : hilos)
+            h.join();
+        for (size_t t = 0; t < total; ++t)
+            costeAc[vivos[t / m]] += costes[t];
+        evaluadas = nInst;
+
+        std::sort(vivos.begin(), vivos.end(), [&](size_t a, size_t b) {
+            return costeAc[a] < costeAc[b];
+        });
+        std::cout << "Ronda " << ronda << ": " << vivos.size()
+                  << " configuraciones, " << evaluadas
+                  << " instancias, mejor coste medio "
+                  << costeAc[vivos[0]] / evaluadas << " segundos.\n";
+
+        if (vivos.size() == 1)
+            break;
+        vivos.resize((vivos.size() + 1) / 2);
+        nInst = std::min(instancias.size(), nInst * 2);
+    }
+
+    mejor = candidatos[vivos[0]];
+}
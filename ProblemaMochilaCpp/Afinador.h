@@ -0,0 +1,59 @@
+#ifndef PROBLEMAMOCHILACPP_AFINADOR_H
+#define PROBLEMAMOCHILACPP_AFINADOR_H
+
+#include <vector>
+
+#include "Algoritmos.h"
+
+/*
+ * Busqueda automatica de los parametros del algoritmo genetico. Se sortean
+ * configuraciones y se comparan por el tiempo que tardan en alcanzar una
+ * calidad dada (fraccion del optimo) en un conjunto de instancias, usando
+ * reduccion a la mitad sucesiva: en cada ronda se descarta la peor mitad de
+ * las configuraciones y se dobla el numero de instancias de las que quedan.
+ */
+
+struct InstanciaAfinado {
+    double M;
+    std::vector<ObjetoReal> objetos;
+    double objetivo;    //Valor que hay que alcanzar
+};
+
+struct ParamAfinador {
+    int nCandidatos = 32;           //Configuraciones a probar
+    int instanciasIniciales = 2;    //Instancias por config. en la 1a ronda
+    double tiempoMax = 1;           //Segundos maximos por ejecucion
+    int nHilos = 0;                 //0 = tantos como nucleos
+    unsigned int semilla = 1;
+};
+
+/**
+ * Coste de una ejecucion del algoritmo genetico: los segundos que tarda en
+ * alcanzar el objetivo de la instancia o, si no lo alcanza, PENALIZACION
+ * veces el tiempo maximo.
+ *
+ * @param ins Instancia con su objetivo.
+ * @param config Parametros del algoritmo genetico.
+ * @param tiempoMax Segundos maximos de la ejecucion.
+ * @return Coste de la ejecucion en segundos.
+ */
+double costeGenetico(InstanciaAfinado const &ins, ConfigGenetico config,
+                     double tiempoMax);
+
+/**
+ * Busca la configuracion del algoritmo genetico que alcanza antes el
+ * objetivo de las instancias. La primera candidata son los parametros por
+ * defecto y el resto se sortean. Las ejecuciones de cada ronda se reparten
+ * entre nHilos hilos y todas las configuraciones usan la misma semilla en
+ * cada instancia. Muestra por pantalla el resultado de cada ronda.
+ *
+ * Coste: O(k log k) ejecuciones, k = numero de candidatas.
+ *
+ * @param instancias Instancias de la clase para la que se afina.
+ * @param param Parametros de la busqueda.
+ * @param mejor Mejor configuracion encontrada.
+ */
+void afinaGenetico(std::vector<InstanciaAfinado> const &instancias,
+                   ParamAfinador const &param, ConfigGenetico &mejor);
+
+#endif //PROBLEMAMOCHILACPP_AFINADOR_H
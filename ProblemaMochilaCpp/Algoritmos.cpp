@@ -1,9 +1,34 @@
 #include "Algoritmos.h"
+#include "ColaNodos.h"
+#include "MatrizBits.h"
+#include "MochilaPequenya.h"
 
 #include <vector>
+#include <deque>
 #include <algorithm>
-#include <queue>
 #include <cmath>
+#include <cstring>
+#include <thread>
+#include <functional>
+#include <limits>
+#include <new>
+#include <random>
+#include <chrono>
+
+/**
+ * Calcula las densidades de los objetos y las ordena de mayor a menor.
+ */
+static void ordenaDensidades(std::vector<ObjetoReal> const &objetos,
+                             std::vector<Densidad> &d, Perfil *perfil) {
+    MedidaAmbito medida(perfil, FASE_ORDENACION);
+    const size_t n = objetos.size();
+    d.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        d[i].densidad = objetos[i].valor / objetos[i].peso;
+        d[i].obj = i;    //Para saber a que objeto corresponde
+    }
+    std::sort(d.begin(), d.end(), std::greater<Densidad>());
+}
 
 /**
  * Resuelve el problema de la mochila con objetos fraccionables mediante un
@@ -16,82 +41,1319 @@
  * @param M Peso maximo que soporta la mochila.
  * @param solucion Indica cuanto se debe coger de cada objeto [0, 1].
  * @param valorSol Valor de la mochila con los objetos dados por solucion.
+ * @param perfil Si no es nullptr, acumula las medidas de cada fase.
+ */
+void mochilaVoraz(std::vector<ObjetoReal> const &objetos, double M,
+                  std::vector<double> &solucion, double &valorSol,
+                  Perfil *perfil) {
+    const size_t n = objetos.size();
+
+    //Ordenamos de mayor a menor las densidades de cada objeto
+    std::vector<Densidad> d;
+    ordenaDensidades(objetos, d, perfil);
+
+    //Cogemos los objetos mientras quepan enteros
+    valorSol = 0;
+    size_t i;
+    for (i = 0; i < n && M - objetos[d[i].obj].peso >= 0; ++i) {
+        valorSol += objetos[d[i].obj].valor;
+        M -= objetos[d[i].obj].peso;
+        solucion[d[i].obj] = 1;
+    }
+
+    //Si aun no se ha llenado la mochila completamos partiendo el objeto
+    if (M > 0) {
+        solucion[d[i].obj] = M / objetos[d[i].obj].peso;
+        valorSol += objetos[d[i].obj].valor * solucion[d[i].obj];
+    }
+}
+
+/**
+ * Igual que la anterior pero devuelve la solucion dispersa: los objetos
+ * cogidos enteros, ordenados, y el objeto partido. No se reserva ni se
+ * pone a cero ningun vector de n posiciones para la solucion, y en lugar
+ * de ordenar todas las densidades se busca el objeto critico partiendo
+ * por la mediana (nth_element), asi que solo se ordenan los cogidos. Con
+ * densidades repetidas puede coger otros objetos que la anterior, con el
+ * mismo valor.
+ *
+ * Coste en tiempo: O(n + k logk) en promedio, n = numero de objetos,
+ * k = numero de objetos cogidos.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param solucion Objetos que se cogen y cuanto del objeto partido.
+ * @param valorSol Valor de la mochila con los objetos dados por solucion.
+ * @param perfil Si no es nullptr, acumula las medidas de cada fase.
  */
 void mochilaVoraz(std::vector<ObjetoReal> const &objetos, double M,
-                  std::vector<double> &solucion, double &valorSol) {
+                  SolucionDispersa &solucion, double &valorSol,
+                  Perfil *perfil) {
+    const size_t n = objetos.size();
+    std::vector<Densidad> d(n);
+    size_t i = 0;
+    {
+        MedidaAmbito medida(perfil, FASE_ORDENACION);
+        for (size_t j = 0; j < n; ++j) {
+            d[j].densidad = objetos[j].valor / objetos[j].peso;
+            d[j].obj = j;
+        }
+
+        //Los objetos de [0, i) caben y el critico esta en [i, fin)
+        size_t fin = n;
+        while (fin - i > 1) {
+            size_t medio = i + (fin - i) / 2;
+            std::nth_element(d.begin() + i, d.begin() + medio,
+                             d.begin() + fin, std::greater<Densidad>());
+            double peso = 0;
+            for (size_t j = i; j < medio; ++j)
+                peso += objetos[d[j].obj].peso;
+            if (peso <= M) {
+                M -= peso;
+                i = medio;
+            } else {
+                fin = medio;
+            }
+        }
+        //Si cabe entero es que caben todos
+        if (i < n && objetos[d[i].obj].peso <= M) {
+            M -= objetos[d[i].obj].peso;
+            i++;
+        }
+    }
+
+    solucion.n = n;
+    solucion.cogidos.resize(i);
+    solucion.hayFraccion = false;
+    solucion.objFraccion = 0;
+    solucion.fraccion = 0;
+    valorSol = 0;
+    for (size_t j = 0; j < i; ++j) {
+        valorSol += objetos[d[j].obj].valor;
+        solucion.cogidos[j] = d[j].obj;
+    }
+
+    //Si aun no se ha llenado la mochila completamos partiendo el critico
+    if (M > 0 && i < n) {
+        solucion.hayFraccion = true;
+        solucion.objFraccion = d[i].obj;
+        solucion.fraccion = M / objetos[d[i].obj].peso;
+        valorSol += objetos[d[i].obj].valor * solucion.fraccion;
+    }
+    std::sort(solucion.cogidos.begin(), solucion.cogidos.end());
+}
+
+static const size_t TAM_TESELA = 2048;              //Capacidades por tesela
+//Caben en la cache L2; una fila menor tambien, y entonces no se bloquea
+static const size_t BYTES_ANILLOS = (size_t) 1 << 20;
+
+/**
+ * sig[i] = max(ant[i], desp[i] + valor) y coge[i] = 1 si se coge el objeto
+ * (solo si mejora) para i en [0, len). Sin saltos ni solapamientos para que
+ * el compilador lo vectorice.
+ */
+static inline void maximoTrozo(const double *__restrict ant,
+                               const double *__restrict desp, double valor,
+                               double *__restrict sig,
+                               unsigned char *__restrict coge, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        const double coger = desp[i] + valor;
+        const bool mejor = ant[i] < coger;
+        sig[i] = mejor ? coger : ant[i];
+        coge[i] = mejor;
+    }
+}
+
+/**
+ * Igual que maximoTrozo pero sobre la misma fila: fila[i] = max(fila[i],
+ * desp[i] + valor). desp no puede solaparse con [fila, fila + len).
+ */
+static inline void maximoTrozoEnSitio(double *__restrict fila,
+                                      const double *__restrict desp,
+                                      double valor,
+                                      unsigned char *__restrict coge,
+                                      size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        const double coger = desp[i] + valor;
+        const bool mejor = fila[i] < coger;
+        fila[i] = mejor ? coger : fila[i];
+        coge[i] = mejor;
+    }
+}
+
+/**
+ * Empaqueta 64 bytes a 0 o 1 en una palabra, 8 a la vez: al multiplicar por
+ * 0x0102040810204080 el byte i acaba en el bit 56 + i.
+ */
+static inline uint64_t empaquetaDecision(const unsigned char *coge) {
+    uint64_t palabra = 0;
+    for (int g = 0; g < 8; ++g) {
+        uint64_t bytes;
+        std::memcpy(&bytes, coge + 8 * g, sizeof bytes);
+        palabra |= ((bytes * 0x0102040810204080ULL) >> 56) << (8 * g);
+    }
+    return palabra;
+}
+
+/**
+ * Avanza la fila de la programacion dinamica con un objeto sobre la misma
+ * fila: mochila[j] pasa a ser el mejor valor con capacidad j usando tambien
+ * este objeto. Se recorre de mayor a menor capacidad para que mochila[j -
+ * peso] siga siendo la del objeto anterior, por palabras de 64
+ * capacidades. Con peso >= 64 los j - peso de una palabra estan todos por
+ * debajo de ella, asi que se actualiza de una vez; si no, de una en una.
+ * Guarda en bits si se coge con cada capacidad.
+ *
+ * Coste: O(M), M = peso que soporta la mochila.
+ */
+static void avanzaFila(size_t peso, double valor, unsigned int M,
+                       VectorContado<double> &mochila, uint64_t *bits) {
+    const size_t tam = (size_t) M + 1;
+    unsigned char coge[64];
+    for (size_t p = (tam - 1) / 64 * 64;; p -= 64) {
+        const size_t fin = std::min(tam, p + 64);
+        const size_t q = std::max(p, std::min(fin, peso));
+        std::fill(coge, coge + 64, 0);
+        if (peso >= 64) {
+            maximoTrozoEnSitio(&mochila[q], &mochila[q - peso], valor,
+                               coge + (q - p), fin - q);
+        } else {
+            for (size_t j = fin; j-- > q;) {
+                const double coger = mochila[j - peso] + valor;
+                coge[j - p] = mochila[j] < coger;
+                mochila[j] = coge[j - p] ? coger : mochila[j];
+            }
+        }
+        bits[p / 64] = empaquetaDecision(coge);
+        if (p == 0)
+            break;
+    }
+}
+
+/**
+ * Avanza la fila de la programacion dinamica con los objetos orden[t0, t1)
+ * en una sola pasada. La fila se recorre en teselas de TAM_TESELA
+ * capacidades de menor a mayor y en cada tesela se aplican todos los
+ * objetos seguidos, asi que la fila se lee y escribe una vez por bloque y
+ * no una vez por objeto. El nivel k (la fila tras los k primeros objetos
+ * del bloque) se guarda en un anillo de R posiciones indexado por j % R,
+ * con R >= TAM_TESELA + peso maximo del bloque, de modo que el objeto k + 1
+ * todavia encuentra el nivel k en j - peso aunque sea de una tesela
+ * anterior. R y TAM_TESELA son potencias de 2, asi que una tesela es
+ * contigua en el anillo; solo j - peso puede dar la vuelta. La decision del
+ * objeto orden[t] se guarda en la fila t.
+ *
+ * Coste: O((t1 - t0) M) en tiempo y O((t1 - t0) R) en espacio, M = peso
+ * que soporta la mochila.
+ */
+static void avanzaBloque(std::vector<ObjetoInt> const &objetos,
+                         VectorContado<size_t> const &orden, size_t t0,
+                         size_t t1, size_t R, unsigned int M,
+                         VectorContado<double> &mochila, MatrizBits &decision,
+                         VectorContado<double> &anillos) {
+    const size_t K = t1 - t0, mascara = R - 1, tam = (size_t) M + 1;
+    anillos.resize(K * R);
+    std::vector<unsigned char> coge(TAM_TESELA);
+    for (size_t a = 0; a < tam; a += TAM_TESELA) {
+        const size_t b = std::min(tam, a + TAM_TESELA);
+        const size_t desp = a & mascara;
+
+        //El nivel 0 es la fila antes del bloque
+        std::copy(mochila.begin() + a, mochila.begin() + b,
+                  anillos.begin() + desp);
+
+        for (size_t k = 1; k <= K; ++k) {
+            const double *ant = &anillos[(k - 1) * R];
+            double *sig = k < K ? &anillos[k * R] + desp : &mochila[a];
+            const size_t peso = (size_t) objetos[orden[t0 + k - 1]].peso;
+            const double valor = objetos[orden[t0 + k - 1]].valor;
+            uint64_t *bits = decision.fila(t0 + k - 1);
+
+            //Sin sitio para el objeto se copia el nivel anterior
+            const size_t q0 = std::max(a, std::min(b, peso));
+            std::copy(ant + desp, ant + desp + (q0 - a), sig);
+            std::fill(coge.begin(), coge.end(), 0);
+            for (size_t q = q0; q < b;) {
+                const size_t ini = (q - peso) & mascara;
+                const size_t len = std::min(b - q, R - ini);
+                maximoTrozo(ant + (q & mascara), ant + ini, valor,
+                            sig + (q - a), &coge[q - a], len);
+                q += len;
+            }
+
+            //a es multiplo de 64, asi que cada palabra es de una tesela
+            for (size_t p = a; p < b; p += 64)
+                bits[p / 64] = empaquetaDecision(&coge[p - a]);
+        }
+    }
+}
+
+/**
+ * Rellena la fila y la matriz de decisiones de mochilaProgDin y reconstruye
+ * la solucion. Las reservas se anotan en opciones.memoria y lanzan
+ * std::bad_alloc si superan su limite. Si los anillos de un bloque no caben
+ * en el limite, el bloque se reduce hasta que quepan, hasta un objeto por
+ * pasada, que no los necesita (una degradacion).
+ */
+static void progDinTabla(std::vector<ObjetoInt> const &objetos,
+                         unsigned int M, std::vector<bool> &solucion,
+                         double &valorSol, Perfil *perfil,
+                         OpcionesProgDin const &opciones, bool enFichero) {
+    const size_t n = objetos.size();
+    ContadorMemoria *memoria = opciones.memoria;
+    MedidaAmbito medidaTabla(perfil, FASE_TABLA);
+
+    //mochila[j] es el mejor valor con capacidad j usando los objetos ya
+    // vistos. decision(t, j) indica si se coge el objeto orden[t] con
+    // capacidad j. Los objetos van de menor a mayor peso para que los
+    // bloques agrupen objetos de peso parecido
+    VectorContado<double> mochila(M + 1, 0, memoria);
+    MatrizBits decision(n, (size_t) M + 1, enFichero, memoria);
+    VectorContado<size_t> orden(n, memoria);
+    for (size_t i = 0; i < n; ++i)
+        orden[i] = i;
+    std::stable_sort(orden.begin(), orden.end(), [&](size_t a, size_t b) {
+        return objetos[a].peso < objetos[b].peso;
+    });
+
+    VectorContado<double> anillos(memoria);
+    const size_t maxBloque = (size_t) std::max(1, opciones.objetosPorBloque);
+    bool reducido = false;  //Si algun bloque se ha reducido por el limite
+    for (size_t t = 0; t < n;) {
+        const int peso = objetos[orden[t]].peso;
+        if (peso > (int) M || peso < 0) {  //No cabe o no es valido
+            t++;
+            continue;
+        }
+
+        //Bloque de objetos cuyos anillos caben en BYTES_ANILLOS y en lo que
+        // queda de memoria. Los anillos anteriores se liberan antes de
+        // reservar los nuevos, asi que cuenta lo que ya ocupan
+        size_t fin = std::min(n, t + maxBloque), R = 0;
+        if (mochila.size() * sizeof(double) <= BYTES_ANILLOS)
+            fin = t + 1;
+        while (fin > t + 1) {
+            const size_t pesoMax = (size_t) objetos[orden[fin - 1]].peso;
+            R = 1;
+            while (R < TAM_TESELA + pesoMax)
+                R *= 2;
+            const size_t bytes = (fin - t) * R * sizeof(double);
+            const size_t tiene = anillos.capacity() * sizeof(double);
+            if (pesoMax <= M && bytes <= BYTES_ANILLOS) {
+                if (!memoria || bytes <= tiene ||
+                    memoria->cabe(bytes - tiene))
+                    break;
+                reducido = true;
+            }
+            fin--;
+        }
+        if (fin > t + 1) {
+            if (anillos.capacity() < (fin - t) * R) {
+                VectorContado<double>(memoria).swap(anillos);
+                anillos.reserve((fin - t) * R);
+            }
+            avanzaBloque(objetos, orden, t, fin, R, M, mochila, decision,
+                         anillos);
+            t = fin;
+        } else {
+            avanzaFila((size_t) peso, objetos[orden[t]].valor, M, mochila,
+                       decision.fila(t));
+            t++;
+        }
+    }
+    valorSol = mochila[M];
+    if (reducido)
+        memoria->degradaciones++;
+    medidaTabla.termina();
+
+    //Calculamos que objetos hemos cogido
+    MedidaAmbito medidaRec(perfil, FASE_RECONSTRUCCION);
+    size_t j = M;
+    for (size_t t = n; t-- > 0;) {
+        const size_t i = orden[t];
+        solucion[i] = decision.bit(t, j);
+        if (solucion[i])
+            j -= objetos[i].peso;
+    }
+}
+
+/**
+ * Resuelve el problema de la mochila 0-1 mediante un algoritmo de
+ * programacion dinamica. El peso de cada objeto y el peso maximo de la
+ * mochila deben ser enteros positivos. Si el valor de los objetos es
+ * proporcional a su peso se resuelve con mochilaSumaSubconjuntos.
+ *
+ * Solo se guarda una fila de valores y, para reconstruir la solucion, una
+ * matriz de bits con la decision (coger o no) de cada objeto y capacidad.
+ * Si la matriz ocupa mas de opciones.maxBytesMemoria se guarda en un
+ * fichero temporal proyectado en memoria. Cuando la fila no cabe en la
+ * cache, cada pasada por ella aplica hasta opciones.objetosPorBloque
+ * objetos de peso parecido por teselas (ver avanzaBloque), asi que se lee
+ * de memoria muchas menos veces.
+ *
+ * Con limite en opciones.memoria, si la matriz no cabe junto a la fila se
+ * guarda en el fichero (una degradacion), y si los anillos de un bloque no
+ * caben se aplican menos objetos por pasada, hasta uno (otra). Si ni la
+ * fila cabe se muestra un error y se devuelve la mochila vacia.
+ *
+ * Coste: O(nM) en tiempo, O(M) valores y nM bits en espacio, n = numero
+ * de objetos, M = peso que soporta la mochila.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param solucion Indica si se coge el objeto o no.
+ * @param valorSol Valor de la mochila con los objetos dados por solucion.
+ * @param perfil Si no es nullptr, acumula las medidas de cada fase.
+ * @param opciones Donde se guarda la matriz de decisiones, cuantos
+ * objetos se aplican en cada pasada y la memoria que se puede usar.
+ */
+void mochilaProgDin(std::vector<ObjetoInt> const &objetos, unsigned int M,
+                    std::vector<bool> &solucion, double &valorSol,
+                    Perfil *perfil, OpcionesProgDin const &opciones) {
+    const size_t n = objetos.size();
+    ContadorMemoria *memoria = opciones.memoria;
+
+    //Si el valor es proporcional al peso basta con una tabla de bits
+    if (proporcionConstante(objetos)) {
+        MedidaAmbito medidaTabla(perfil, FASE_TABLA);
+        mochilaSumaSubconjuntos(objetos, M, solucion, valorSol);
+        return;
+    }
+
+    //Con limite de memoria la matriz va al fichero si no cabe junto a la
+    // fila, el orden y los anillos
+    const size_t bytesFilas = ((size_t) M + 1) * sizeof(double) +
+                              n * sizeof(size_t) + BYTES_ANILLOS;
+    const size_t bytesDecision = n * (((size_t) M + 64) / 64) * 8;
+    bool enFichero = bytesDecision > opciones.maxBytesMemoria;
+    if (memoria && !enFichero && !memoria->cabe(bytesFilas + bytesDecision)) {
+        enFichero = true;
+        memoria->degradaciones++;
+    }
+
+    //Si ni asi hay memoria no se resuelve
+    try {
+        progDinTabla(objetos, M, solucion, valorSol, perfil, opciones,
+                     enFichero);
+    } catch (std::bad_alloc const &) {
+        std::cout << "ERROR. La tabla de la programacion dinamica no cabe "
+                     "en memoria.\n";
+        std::fill(solucion.begin(), solucion.end(), false);
+        valorSol = 0;
+    }
+}
+
+/**
+ * Indica si el valor de todos los objetos es proporcional a su peso, es
+ * decir, valor = c * peso con c > 0 la misma constante para todos (por
+ * ejemplo, suma de subconjuntos con c = 1).
+ *
+ * Coste: O(n), n = numero de objetos.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @return Si la proporcion valor / peso es la misma en todos los objetos.
+ */
+bool proporcionConstante(std::vector<ObjetoInt> const &objetos) {
+    if (objetos.empty() || objetos[0].peso <= 0)
+        return false;
+    const double c = objetos[0].valor / objetos[0].peso;
+    if (c <= 0)
+        return false;
+    for (ObjetoInt const &o : objetos) {
+        if (o.peso <= 0 ||
+            std::fabs(o.valor - c * o.peso) > 1e-9 * std::fabs(o.valor))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Numero de ceros al final de x != 0 (indice del bit menos significativo a
+ * 1).
+ */
+static inline int cerosFinales(unsigned long long x) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    int c = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        ++c;
+    }
+    return c;
+#endif
+}
+
+/**
+ * Resuelve el problema de la mochila 0-1 cuando el valor de cada objeto es
+ * proporcional a su peso (ver proporcionConstante). Maximizar el valor es
+ * entonces maximizar el peso, asi que basta con saber que pesos se pueden
+ * alcanzar. Los pesos alcanzables se guardan en un conjunto de bits y cada
+ * objeto se procesa con un desplazamiento y un OR por palabras de 64 bits,
+ * en lugar de una fila de doubles. Para reconstruir la solucion se guarda,
+ * para cada peso, el primer objeto con el que se alcanzo.
+ *
+ * Coste: O(nM / 64 + M) en tiempo y O(M) en espacio, n = numero de objetos,
+ * M = peso que soporta la mochila.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param solucion Indica si se coge el objeto o no.
+ * @param valorSol Valor de la mochila con los objetos dados por solucion.
+ */
+void mochilaSumaSubconjuntos(std::vector<ObjetoInt> const &objetos,
+                             unsigned int M, std::vector<bool> &solucion,
+                             double &valorSol) {
+    const size_t n = objetos.size();
+    const size_t nPalabras = M / 64 + 1;
+    const unsigned long long mascaraUltima =
+            (M % 64 == 63) ? ~0ULL : (1ULL << (M % 64 + 1)) - 1;
+
+    //alcanzable tiene el bit j a 1 si algun subconjunto pesa exactamente j.
+    // primerObjeto[j] = primer objeto con el que se alcanzo el peso j
+    std::vector<unsigned long long> alcanzable(nPalabras, 0);
+    std::vector<unsigned int> primerObjeto(M + 1, 0);
+    alcanzable[0] = 1;
+    size_t maxPalabra = 0;  //Ultima palabra con algun bit a 1
+
+    for (size_t i = 0; i < n; ++i) {
+        const unsigned int w = objetos[i].peso;
+        if (w > M)
+            continue;
+        const size_t q = w / 64;
+        const unsigned int r = w % 64;
+        const size_t hasta = std::min(nPalabras - 1, maxPalabra + q + 1);
+
+        //alcanzable |= alcanzable << w, de la palabra mas alta a la mas
+        // baja para leer siempre los valores de antes de este objeto
+        for (size_t k = hasta + 1; k-- > q;) {
+            unsigned long long desp = alcanzable[k - q] << r;
+            if (r > 0 && k > q)
+                desp |= alcanzable[k - q - 1] >> (64 - r);
+            if (k == nPalabras - 1)
+                desp &= mascaraUltima;
+            unsigned long long nuevos = desp & ~alcanzable[k];
+            if (nuevos) {
+                alcanzable[k] |= nuevos;
+                maxPalabra = std::max(maxPalabra, k);
+                do {
+                    primerObjeto[k * 64 + cerosFinales(nuevos)] = i;
+                    nuevos &= nuevos - 1;
+                } while (nuevos);
+            }
+        }
+    }
+
+    //Mayor peso alcanzable
+    size_t j = maxPalabra * 64 + 63;
+    while (!(alcanzable[j / 64] >> (j % 64) & 1))
+        --j;
+
+    //Seguimos el primer objeto de cada peso; el resto se alcanzo con
+    // objetos anteriores, asi que no se repite ninguno
+    std::fill(solucion.begin(), solucion.end(), false);
+    valorSol = 0;
+    while (j > 0) {
+        const unsigned int i = primerObjeto[j];
+        solucion[i] = true;
+        valorSol += objetos[i].valor;
+        j -= objetos[i].peso;
+    }
+}
+
+static const size_t NINGUNO = (size_t) -1;
+
+//Tamanyo de la cola y del historial a partir del cual mochilaRamPoda quita
+// lo podado (ver compactaHistorial)
+static const size_t MIN_LIMPIEZA = 1024;
+
+/**
+ * Marca en sol los objetos cogidos siguiendo la cadena de decisiones que
+ * termina en hist.
+ *
+ * Coste: O(n), n = numero de objetos.
+ *
+ * @param historial Decisiones de coger un objeto.
+ * @param hist Ultima decision de la solucion (o NINGUNO).
+ * @param sol Indica si se coge el objeto o no.
+ */
+template<class Asignador>
+void reconstruyeSolucion(std::vector<Decision, Asignador> const &historial,
+                         size_t hist, std::vector<bool> &sol) {
+    std::fill(sol.begin(), sol.end(), false);
+    for (size_t h = hist; h != NINGUNO; h = historial[h].padre)
+        sol[historial[h].obj] = true;
+}
+
+/**
+ * Quita del historial las decisiones a las que no llega ningun nodo de la
+ * cola (las de nodos ya podados o ya expandidos) y renumera las que quedan
+ * y el hist de los nodos. Una decision siempre esta detras de su padre, asi
+ * que basta una pasada hacia delante. Si la tabla de renumeracion no cabe
+ * en el limite de memoria no se hace nada. La capacidad del historial no se
+ * devuelve: las siguientes decisiones reutilizan el hueco.
+ *
+ * Coste: O(h + m) en tiempo y O(h) en espacio, h = tamanyo del historial,
+ * m = nodos en la cola.
+ *
+ * @param historial Decisiones de coger un objeto.
+ * @param C Cola de nodos vivos; no puede haber nodos fuera de ella.
+ * @param nodos Almacen de los nodos de la cola.
+ * @param memoria Contador de memoria del historial (o nullptr).
+ */
+template<class Asignador>
+void compactaHistorial(std::vector<Decision, Asignador> &historial,
+                       ColaNodos const &C, PoolNodos &nodos,
+                       ContadorMemoria *memoria) {
+    const size_t h = historial.size();
+    if (memoria && !memoria->cabe(h * sizeof(size_t)))
+        return;
+    VectorContado<size_t> nuevo(h, NINGUNO, memoria);
+
+    //Marcamos (con 0) las decisiones de algun nodo vivo
+    for (size_t i = 0; i < C.tamanyo(); ++i) {
+        size_t j = nodos[C.nodo(i)].hist;
+        while (j != NINGUNO && nuevo[j] == NINGUNO) {
+            nuevo[j] = 0;
+            j = historial[j].padre;
+        }
+    }
+
+    size_t quedan = 0;
+    for (size_t j = 0; j < h; ++j) {
+        if (nuevo[j] == NINGUNO)
+            continue;
+        size_t padre = historial[j].padre;
+        historial[quedan] = {historial[j].obj,
+                             padre == NINGUNO ? NINGUNO : nuevo[padre]};
+        nuevo[j] = quedan++;
+    }
+    historial.resize(quedan);
+
+    for (size_t i = 0; i < C.tamanyo(); ++i) {
+        NodoRamPoda &x = nodos[C.nodo(i)];
+        if (x.hist != NINGUNO)
+            x.hist = nuevo[x.hist];
+    }
+}
+
+/**
+ * Reserva lo que puede pedir un paso de mochilaRamPoda: dos nodos en la
+ * cola y en el almacen y una decision en el historial.
+ *
+ * Coste: O(1) amortizado.
+ *
+ * @return False si no cabe en el limite de memoria; no cambia nada.
+ */
+template<class Asignador>
+bool reservaPaso(ColaNodos &C, PoolNodos &nodos,
+                 std::vector<Decision, Asignador> &historial) {
+    try {
+        C.reserva(2);
+        nodos.reserva(2);
+        if (historial.size() == historial.capacity())
+            historial.reserve(std::max<size_t>(2 * historial.capacity(), 1));
+    } catch (std::bad_alloc const &) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Calcula la cota optimista (voraz fraccionada) de un estado usando las
+ * sumas acumuladas de pesos y valores de los objetos ordenados por densidad.
+ *
+ * Coste: O(log n), n = numero de objetos.
+ *
+ * @param pesosAc pesosAc[i] = suma de los pesos de los i primeros objetos
+ * en orden de densidad decreciente.
+ * @param valoresAc Igual que pesosAc pero con los valores.
+ * @param s Primer objeto (en orden de densidad) aun sin decidir.
+ * @param hueco Capacidad que le queda libre a la mochila.
+ * @param valorAc Valor acumulado en la mochila.
+ * @return Cota superior del valor alcanzable desde el estado.
+ */
+double cotaVorazAcumulada(std::vector<double> const &pesosAc,
+                          std::vector<double> const &valoresAc, size_t s,
+                          double hueco, double valorAc) {
+    const size_t n = pesosAc.size() - 1;
+
+    //t = ultimo indice tal que los objetos [s, t) caben enteros
+    size_t t = std::upper_bound(pesosAc.begin() + s, pesosAc.end(),
+                                pesosAc[s] + hueco) - pesosAc.begin() - 1;
+    double cota = valorAc + valoresAc[t] - valoresAc[s];
+    if (t < n) {    //Fraccionamos el objeto t
+        double pesoT = pesosAc[t + 1] - pesosAc[t];
+        double valorT = valoresAc[t + 1] - valoresAc[t];
+        cota += (hueco - (pesosAc[t] - pesosAc[s])) / pesoT * valorT;
+    }
+    return cota;
+}
+
+/**
+ * Calcula una cota optimista mas ajustada que la de Dantzig (ver TipoCota)
+ * a partir de las sumas acumuladas de pesos y valores de los objetos
+ * ordenados por densidad.
+ *
+ * Coste: O(log n), n = numero de objetos.
+ *
+ * @param pesosAc pesosAc[i] = suma de los pesos de los i primeros objetos
+ * en orden de densidad decreciente.
+ * @param valoresAc Igual que pesosAc pero con los valores.
+ * @param tipo COTA_MARTELLO_TOTH o COTA_CRITICO.
+ * @param s Primer objeto (en orden de densidad) aun sin decidir.
+ * @param hueco Capacidad que le queda libre a la mochila.
+ * @param valorAc Valor acumulado en la mochila.
+ * @return Cota superior del valor alcanzable desde el estado.
+ */
+double cotaAjustada(std::vector<double> const &pesosAc,
+                    std::vector<double> const &valoresAc, TipoCota tipo,
+                    size_t s, double hueco, double valorAc) {
+    const size_t n = pesosAc.size() - 1;
+
+    //c = objeto critico: los objetos [s, c) caben enteros y c no
+    size_t c = std::upper_bound(pesosAc.begin() + s, pesosAc.end(),
+                                pesosAc[s] + hueco) - pesosAc.begin() - 1;
+    const double valorVoraz = valorAc + valoresAc[c] - valoresAc[s];
+    if (c >= n)     //Caben todos
+        return valorVoraz;
+    const double resto = hueco - (pesosAc[c] - pesosAc[s]);
+    const double pesoC = pesosAc[c + 1] - pesosAc[c];
+    const double valorC = valoresAc[c + 1] - valoresAc[c];
+
+    double sinC, conC = -std::numeric_limits<double>::infinity();
+    if (tipo == COTA_MARTELLO_TOTH) {
+        //Sin c llenamos el resto con la densidad del siguiente; con c
+        // quitamos lo que sobra con la densidad del anterior
+        sinC = valorVoraz;
+        if (c + 1 < n)
+            sinC += resto * (valoresAc[c + 2] - valoresAc[c + 1]) /
+                    (pesosAc[c + 2] - pesosAc[c + 1]);
+        if (c > s)
+            conC = valorVoraz + valorC - (pesoC - resto) *
+                                         (valoresAc[c] - valoresAc[c - 1]) /
+                                         (pesosAc[c] - pesosAc[c - 1]);
+    } else {
+        //Cota de Dantzig de cada rama. Con c dentro el nuevo critico esta
+        // antes de c, asi que no hace falta quitarlo de las sumas
+        sinC = cotaVorazAcumulada(pesosAc, valoresAc, c + 1, resto,
+                                  valorVoraz);
+        if (pesoC <= hueco)
+            conC = cotaVorazAcumulada(pesosAc, valoresAc, s, hueco - pesoC,
+                                      valorAc + valorC);
+    }
+
+    //Margen para los errores de redondeo de las sumas acumuladas
+    double cota = std::max(sinC, conC);
+    return cota + 1e-9 * std::max(1.0, std::fabs(cota));
+}
+
+/**
+ * Resuelve el problema de la mochila 0-1 mediante programacion dinamica
+ * dispersa (Nemhauser-Ullmann). En lugar de una tabla indexada por la
+ * capacidad se mantiene solo la lista de estados (peso, valor) no
+ * dominados, ordenada por peso creciente. Admite pesos reales y valores de M
+ * arbitrariamente grandes. Ademas se descartan los estados cuya cota
+ * optimista (voraz fraccionada) no supera la mejor solucion conocida.
+ *
+ * Coste: O(n L) en tiempo y espacio, n = numero de objetos, L = tamanyo
+ * maximo de la lista de estados no dominados (en el peor caso 2^n, en
+ * instancias aleatorias tipicas mucho menor que M).
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param solucion Indica si se coge el objeto o no.
+ * @param valorSol Valor de la mochila con los objetos dados por solucion.
+ */
+void mochilaProgDinDispersa(std::vector<ObjetoReal> const &objetos, double M,
+                            std::vector<bool> &solucion, double &valorSol) {
+    const size_t n = objetos.size();
+
+    //Calculamos las densidades de cada objeto y las ordenamos de mayor a
+    // menor, asi las cotas son ajustadas y las listas se mantienen pequenyas
+    std::vector<Densidad> d(n);
+    for (size_t i = 0; i < n; ++i) {
+        d[i].densidad = objetos[i].valor / objetos[i].peso;
+        d[i].obj = i;
+    }
+    std::sort(d.begin(), d.end(), std::greater<Densidad>());
+
+    //Sumas acumuladas para calcular la cota optimista en O(log n)
+    std::vector<double> pesosAc(n + 1, 0), valoresAc(n + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        pesosAc[i + 1] = pesosAc[i] + objetos[d[i].obj].peso;
+        valoresAc[i + 1] = valoresAc[i] + objetos[d[i].obj].valor;
+    }
+
+    //Solucion voraz 0-1 como mejor valor inicial
+    double mejor = 0, hueco = M;
+    for (size_t i = 0; i < n; ++i) {
+        if (objetos[d[i].obj].peso <= hueco) {
+            hueco -= objetos[d[i].obj].peso;
+            mejor += objetos[d[i].obj].valor;
+        }
+    }
+
+    //Listas de estados (reutilizadas en cada iteracion) e historial de
+    // decisiones compartido por todos los estados
+    std::vector<Estado> actual, siguiente;
+    std::vector<Decision> historial;
+    actual.reserve(n + 1);
+    siguiente.reserve(n + 1);
+    actual.push_back({0, 0, NINGUNO});
+
+    for (size_t k = 0; k < n; ++k) {
+        const double peso = objetos[d[k].obj].peso;
+        const double valor = objetos[d[k].obj].valor;
+        const double tolerancia = 1e-9 * std::max(1.0, mejor);
+        siguiente.clear();
+
+        //Fusionamos la lista sin coger el objeto (i) con la lista cogiendolo
+        // (j), ambas ordenadas por peso, quedandonos con los no dominados
+        size_t i = 0, j = 0;
+        double valorVisto = -1;
+        while (i < actual.size() ||
+               (j < actual.size() && actual[j].peso + peso <= M)) {
+            Estado e;
+            bool cogido;
+            if (j >= actual.size() || actual[j].peso + peso > M ||
+                (i < actual.size() &&
+                 (actual[i].peso < actual[j].peso + peso ||
+                  (actual[i].peso == actual[j].peso + peso &&
+                   actual[i].valor >= actual[j].valor + valor)))) {
+                e = actual[i++];
+                cogido = false;
+            } else {
+                e.peso = actual[j].peso + peso;
+                e.valor = actual[j].valor + valor;
+                e.hist = actual[j++].hist;
+                cogido = true;
+            }
+
+            if (e.valor <= valorVisto) //Dominado por un estado anterior
+                continue;
+            valorVisto = e.valor;
+
+            //Descartamos el estado si su cota no alcanza la mejor solucion
+            if (cotaVorazAcumulada(pesosAc, valoresAc, k + 1, M - e.peso,
+                                   e.valor) + tolerancia < mejor)
+                continue;
+
+            if (cogido) {
+                historial.push_back({d[k].obj, e.hist});
+                e.hist = historial.size() - 1;
+            }
+            mejor = std::max(mejor, e.valor);
+            siguiente.push_back(e);
+        }
+        std::swap(actual, siguiente);
+    }
+
+    //El ultimo estado es el de mayor valor. Reconstruimos la solucion
+    valorSol = actual.back().valor;
+    reconstruyeSolucion(historial, actual.back().hist, solucion);
+}
+
+struct ListaSubconjuntos {
+    std::vector<double> pesos;
+    std::vector<double> valores;
+    std::vector<unsigned long long> mascaras;   //Objetos de la mitad cogidos
+};
+
+/**
+ * Enumera los subconjuntos de los objetos [ini, fin) que caben en la
+ * mochila, ordenados por peso creciente y sin estados dominados (el valor
+ * es estrictamente creciente). Anyade los objetos de uno en uno fusionando
+ * la lista actual con la misma lista desplazada por el objeto.
+ *
+ * Coste: O((fin - ini) 2^(fin - ini)) en el peor caso.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param ini Primer objeto de la mitad.
+ * @param fin Objeto siguiente al ultimo de la mitad (fin - ini <= 64).
+ * @param M Peso maximo que soporta la mochila.
+ * @param lista Lista resultante.
+ */
+void enumeraSubconjuntos(std::vector<ObjetoReal> const &objetos, size_t ini,
+                         size_t fin, double M, ListaSubconjuntos &lista) {
+    ListaSubconjuntos desp, sig;
+    lista.pesos.assign(1, 0);
+    lista.valores.assign(1, 0);
+    lista.mascaras.assign(1, 0);
+
+    for (size_t i = ini; i < fin; ++i) {
+        const double peso = objetos[i].peso, valor = objetos[i].valor;
+        const unsigned long long bit = 1ULL << (i - ini);
+        const size_t m = lista.pesos.size();
+
+        //Lista desplazada. Bucle sin dependencias: el compilador lo vectoriza
+        desp.pesos.resize(m);
+        desp.valores.resize(m);
+        desp.mascaras.resize(m);
+        for (size_t j = 0; j < m; ++j) {
+            desp.pesos[j] = lista.pesos[j] + peso;
+            desp.valores[j] = lista.valores[j] + valor;
+            desp.mascaras[j] = lista.mascaras[j] | bit;
+        }
+
+        //Fusionamos por peso descartando los dominados y los que no caben
+        sig.pesos.clear();
+        sig.valores.clear();
+        sig.mascaras.clear();
+        size_t a = 0, b = 0;
+        double valorVisto = -1;
+        while (a < m || (b < m && desp.pesos[b] <= M)) {
+            ListaSubconjuntos const *l;
+            size_t j;
+            if (b >= m || desp.pesos[b] > M ||
+                (a < m && (lista.pesos[a] < desp.pesos[b] ||
+                           (lista.pesos[a] == desp.pesos[b] &&
+                            lista.valores[a] >= desp.valores[b])))) {
+                l = &lista;
+                j = a++;
+            } else {
+                l = &desp;
+                j = b++;
+            }
+            if (l->valores[j] > valorVisto) {
+                valorVisto = l->valores[j];
+                sig.pesos.push_back(l->pesos[j]);
+                sig.valores.push_back(l->valores[j]);
+                sig.mascaras.push_back(l->mascaras[j]);
+            }
+        }
+        std::swap(lista, sig);
+    }
+}
+
+//Objetos a partir de los que mochilaMitades no enumera las mitades: cada
+// lista puede tener hasta 2^(n/2) subconjuntos
+static const size_t MAX_OBJETOS_MITADES = 64;
+
+/**
+ * Resuelve el problema de la mochila 0-1 mediante el algoritmo de
+ * Horowitz-Sahni (encuentro en el medio). Se enumeran los subconjuntos de
+ * cada mitad de los objetos (cada mitad en un hilo) en listas ordenadas por
+ * peso y sin estados dominados, y se combinan con un unico recorrido de dos
+ * punteros. Admite pesos reales y M arbitrariamente grande y su coste no
+ * depende de la correlacion entre pesos y valores. Con n > 64 las listas
+ * podrian no caber en memoria, asi que se resuelve con
+ * mochilaProgDinDispersa.
+ *
+ * Coste: O(n 2^(n/2)) en tiempo y O(2^(n/2)) en espacio con n <= 64, n =
+ * numero de objetos.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param solucion Indica si se coge el objeto o no.
+ * @param valorSol Valor de la mochila con los objetos dados por solucion.
+ */
+void mochilaMitades(std::vector<ObjetoReal> const &objetos, double M,
+                    std::vector<bool> &solucion, double &valorSol) {
     const size_t n = objetos.size();
+    if (n > MAX_OBJETOS_MITADES) {
+        mochilaProgDinDispersa(objetos, M, solucion, valorSol);
+        return;
+    }
+
+    //Enumeramos cada mitad en un hilo distinto
+    const size_t mitad = n / 2;
+    ListaSubconjuntos A, B;
+    std::thread hilo(enumeraSubconjuntos, std::cref(objetos), 0, mitad, M,
+                     std::ref(A));
+    enumeraSubconjuntos(objetos, mitad, n, M, B);
+    hilo.join();
+
+    //Recorremos A de menor a mayor peso y B de mayor a menor. Como las
+    // listas no tienen dominados, B[j] es el mejor complemento de A[i]
+    valorSol = -1;
+    size_t mejorA = 0, mejorB = 0;
+    size_t j = B.pesos.size();
+    for (size_t i = 0; i < A.pesos.size(); ++i) {
+        while (j > 0 && A.pesos[i] + B.pesos[j - 1] > M)
+            --j;
+        if (j == 0)
+            break;
+        if (A.valores[i] + B.valores[j - 1] > valorSol) {
+            valorSol = A.valores[i] + B.valores[j - 1];
+            mejorA = i;
+            mejorB = j - 1;
+        }
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        if (i < mitad)
+            solucion[i] = (A.mascaras[mejorA] >> i) & 1;
+        else
+            solucion[i] = (B.mascaras[mejorB] >> (i - mitad)) & 1;
+    }
+}
+
+/**
+ * Programacion dinamica indexada por el valor con valores enteros dados
+ * aparte de los objetos (para poder usarla con valores escalados).
+ *
+ * Coste: O(nV) en tiempo, O(V) en memoria para los pesos y nV bits para las
+ * decisiones, n = numero de objetos, V = suma de los valores.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param valores Valor entero de cada objeto.
+ * @param M Peso maximo que soporta la mochila.
+ * @param solucion Indica si se coge el objeto o no.
+ */
+void progDinValor(std::vector<ObjetoReal> const &objetos,
+                  std::vector<long long> const &valores, double M,
+                  std::vector<bool> &solucion) {
+    const size_t n = objetos.size();
+    const double INF = std::numeric_limits<double>::infinity();
+
+    //Los objetos que no caben solos no se tienen en cuenta
+    long long V = 0;
+    for (size_t i = 0; i < n; ++i)
+        if (objetos[i].peso <= M)
+            V += valores[i];
+
+    //minPeso[p] = minimo peso con el que se consigue exactamente valor p.
+    // cogido[i * (V + 1) + p] indica si el objeto i mejora minPeso[p]
+    std::vector<double> minPeso(V + 1, INF);
+    std::vector<bool> cogido(n * (V + 1), false);
+    minPeso[0] = 0;
+    long long VAc = 0;  //Valor maximo alcanzable con los objetos vistos
+    for (size_t i = 0; i < n; ++i) {
+        if (objetos[i].peso > M)
+            continue;
+        const long long v = valores[i];
+        const double peso = objetos[i].peso;
+        VAc += v;
+        for (long long p = VAc; p >= v; --p) {
+            if (minPeso[p - v] + peso < minPeso[p]) {
+                minPeso[p] = minPeso[p - v] + peso;
+                cogido[i * (V + 1) + p] = true;
+            }
+        }
+    }
+
+    //El mayor valor cuyo peso minimo cabe en la mochila
+    long long p = V;
+    while (minPeso[p] > M)
+        --p;
+
+    //Calculamos que objetos hemos cogido
+    for (size_t i = n; i-- > 0;) {
+        solucion[i] = cogido[i * (V + 1) + p];
+        if (solucion[i])
+            p -= valores[i];
+    }
+}
+
+/**
+ * Resuelve el problema de la mochila 0-1 mediante programacion dinamica
+ * indexada por el valor: para cada valor alcanzable se guarda el minimo
+ * peso necesario para conseguirlo. Los valores de los objetos deben ser
+ * enteros no negativos; los pesos y M pueden ser reales y tan grandes como
+ * se quiera.
+ *
+ * Coste: O(nV) en tiempo, O(V) en memoria para los pesos y nV bits para las
+ * decisiones, n = numero de objetos, V = suma de los valores.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param solucion Indica si se coge el objeto o no.
+ * @param valorSol Valor de la mochila con los objetos dados por solucion.
+ */
+void mochilaProgDinValor(std::vector<ObjetoReal> const &objetos, double M,
+                         std::vector<bool> &solucion, double &valorSol) {
+    std::vector<long long> valores(objetos.size());
+    for (size_t i = 0; i < objetos.size(); ++i)
+        valores[i] = std::llround(objetos[i].valor);
+
+    progDinValor(objetos, valores, M, solucion);
+
+    valorSol = 0;
+    for (size_t i = 0; i < objetos.size(); ++i)
+        if (solucion[i])
+            valorSol += objetos[i].valor;
+}
+
+/**
+ * Resuelve el problema de la mochila 0-1 de forma aproximada (FPTAS).
+ * Escala los valores por K = epsilon * vMax / n, los redondea hacia abajo y
+ * resuelve el problema escalado con mochilaProgDinValor. Se garantiza que
+ * valorSol >= (1 - epsilon) * optimo. Cuanto menor es epsilon mas precisa
+ * y mas lenta es la resolucion.
+ *
+ * Coste: O(n^3 / epsilon) en tiempo, n = numero de objetos.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param epsilon Error relativo maximo admitido, en (0, 1).
+ * @param solucion Indica si se coge el objeto o no.
+ * @param valorSol Valor de la mochila con los objetos dados por solucion.
+ */
+void mochilaFPTAS(std::vector<ObjetoReal> const &objetos, double M,
+                  double epsilon, std::vector<bool> &solucion,
+                  double &valorSol) {
+    const size_t n = objetos.size();
+
+    //Mayor valor de un objeto que cabe solo en la mochila
+    double vMax = 0;
+    for (ObjetoReal const &o : objetos)
+        if (o.peso <= M)
+            vMax = std::max(vMax, o.valor);
+
+    //Escalamos los valores. Cada objeto pierde menos de K, asi que la
+    // solucion pierde menos de nK = epsilon * vMax <= epsilon * optimo
+    std::vector<long long> valores(n, 0);
+    if (vMax > 0) {
+        const double K = epsilon * vMax / n;
+        for (size_t i = 0; i < n; ++i)
+            valores[i] = (long long) std::floor(objetos[i].valor / K);
+    }
+
+    progDinValor(objetos, valores, M, solucion);
+
+    valorSol = 0;
+    for (size_t i = 0; i < n; ++i)
+        if (solucion[i])
+            valorSol += objetos[i].valor;
+}
+
+struct EstadoLocal {
+    std::vector<size_t> orden;          //Objetos en orden de densidad
+    std::vector<double> peso, valor;    //Del objeto orden[p]
+    size_t iniCore, finCore;            //Nucleo: posiciones [ini, fin)
+    std::vector<bool> dentro;           //dentro[p]: se coge orden[p]
+    double hueco, valorAc;
+};
+
+/**
+ * Prepara la busqueda local: ordena los objetos por densidad, copia sus
+ * pesos y valores en ese orden y fija el nucleo alrededor del objeto
+ * critico de la solucion voraz.
+ *
+ * Coste: O(n logn), n = numero de objetos.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param tamCore Numero de objetos del nucleo.
+ * @param est Estado de la busqueda.
+ */
+void preparaLocal(std::vector<ObjetoReal> const &objetos, double M,
+                  size_t tamCore, EstadoLocal &est) {
+    const size_t n = objetos.size();
+    std::vector<Densidad> d(n);
+    for (size_t i = 0; i < n; ++i) {
+        d[i].densidad = objetos[i].valor / objetos[i].peso;
+        d[i].obj = i;
+    }
+    std::sort(d.begin(), d.end(), std::greater<Densidad>());
+
+    est.orden.resize(n);
+    est.peso.resize(n);
+    est.valor.resize(n);
+    size_t critico = n;
+    double pesoAc = 0;
+    for (size_t p = 0; p < n; ++p) {
+        est.orden[p] = d[p].obj;
+        est.peso[p] = objetos[d[p].obj].peso;
+        est.valor[p] = objetos[d[p].obj].valor;
+        pesoAc += est.peso[p];
+        if (pesoAc > M && critico == n)
+            critico = p;
+    }
+    est.iniCore = critico > tamCore / 2 ? critico - tamCore / 2 : 0;
+    est.finCore = std::min(n, est.iniCore + tamCore);
+    est.dentro.assign(n, false);
+}
+
+/**
+ * Cambia el objeto de la posicion p de dentro a fuera de la mochila o al
+ * reves. Coste: O(1).
+ */
+static void cambiaLocal(EstadoLocal &est, size_t p) {
+    if (est.dentro[p]) {
+        est.hueco += est.peso[p];
+        est.valorAc -= est.valor[p];
+    } else {
+        est.hueco -= est.peso[p];
+        est.valorAc += est.valor[p];
+    }
+    est.dentro[p] = !est.dentro[p];
+}
+
+/**
+ * Descenso por los vecindarios anyadir, intercambio 1-1 y 2-1 hasta que
+ * ningun movimiento mejora. Cada movimiento se evalua en O(1) con el hueco
+ * que queda en la mochila. Los intercambios se buscan solo en el nucleo.
+ *
+ * Coste: O(n + c^3) por mejora, n = numero de objetos, c = tamanyo del
+ * nucleo.
+ *
+ * @param est Estado de la busqueda, con una solucion factible.
+ */
+void descensoLocal(EstadoLocal &est) {
+    const size_t n = est.orden.size();
+    const size_t ini = est.iniCore, fin = est.finCore;
+    bool mejora = true;
+    while (mejora) {
+        mejora = false;
+        const double tol = 1e-9 * std::max(1.0, est.valorAc);
+
+        //Anyadir: todos los que quepan, en orden de densidad
+        for (size_t p = 0; p < n; ++p)
+            if (!est.dentro[p] && est.peso[p] <= est.hueco)
+                cambiaLocal(est, p);
+
+        //Intercambio 1-1: sacar i y meter j
+        for (size_t i = ini; i < fin && !mejora; ++i) {
+            if (!est.dentro[i])
+                continue;
+            for (size_t j = ini; j < fin && !mejora; ++j) {
+                if (!est.dentro[j] &&
+                    est.peso[j] - est.peso[i] <= est.hueco &&
+                    est.valor[j] - est.valor[i] > tol) {
+                    cambiaLocal(est, i);
+                    cambiaLocal(est, j);
+                    mejora = true;
+                }
+            }
+        }
+
+        //Intercambio 2-1: sacar i1 e i2 y meter j, o sacar i y meter j1 y j2
+        for (size_t a = ini; a < fin && !mejora; ++a) {
+            for (size_t b = a + 1; b < fin && !mejora; ++b) {
+                if (est.dentro[a] != est.dentro[b])
+                    continue;
+                const double pesoAB = est.peso[a] + est.peso[b];
+                const double valorAB = est.valor[a] + est.valor[b];
+                for (size_t c = ini; c < fin && !mejora; ++c) {
+                    if (est.dentro[c] == est.dentro[a])
+                        continue;
+                    bool factible, gana;
+                    if (est.dentro[a]) {    //Salen a y b, entra c
+                        factible = est.peso[c] - pesoAB <= est.hueco;
+                        gana = est.valor[c] - valorAB > tol;
+                    } else {                //Sale c, entran a y b
+                        factible = pesoAB - est.peso[c] <= est.hueco;
+                        gana = valorAB - est.valor[c] > tol;
+                    }
+                    if (factible && gana) {
+                        cambiaLocal(est, a);
+                        cambiaLocal(est, b);
+                        cambiaLocal(est, c);
+                        mejora = true;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Mejora la solucion sol por busqueda local: descenso y, si maxSacudidas >
+ * 0, busqueda de vecindario variable. En cada sacudida se cambian k objetos
+ * del nucleo al azar, se quitan los de menor densidad hasta que quepa y se
+ * desciende. Si mejora se acepta y k vuelve a 1; si no, se vuelve a la
+ * mejor solucion y se aumenta k (hasta K_MAX_SACUDIDA).
+ *
+ * Coste: O(s(n + c^3)), n = numero de objetos, c = tamanyo del nucleo, s =
+ * numero de sacudidas.
+ *
+ * @param est Estado preparado con preparaLocal.
+ * @param M Peso maximo que soporta la mochila.
+ * @param maxSacudidas Sacudidas seguidas sin mejora antes de terminar.
+ * @param gen Generador de numeros aleatorios.
+ * @param sol Solucion factible a mejorar, en el orden original.
+ * @param valorSol Valor de la solucion.
+ */
+void mejoraLocal(EstadoLocal &est, double M, int maxSacudidas,
+                 std::mt19937 &gen, std::vector<bool> &sol,
+                 double &valorSol) {
+    static const int K_MAX_SACUDIDA = 5;
+    const size_t n = est.orden.size();
+    if (n == 0)
+        return;
 
-    //Calculamos las densidades de cada objeto
-    std::vector<Densidad> d(n);
-    for (size_t i = 0; i < n; ++i) {
-        d[i].densidad = objetos[i].valor / objetos[i].peso;
-        d[i].obj = i;    //Para saber a que objeto corresponde
+    //Pasamos la solucion al orden de densidad
+    est.hueco = M;
+    est.valorAc = 0;
+    for (size_t p = 0; p < n; ++p) {
+        est.dentro[p] = false;
+        if (sol[est.orden[p]])
+            cambiaLocal(est, p);
     }
+    descensoLocal(est);
 
-    //Ordenamos de mayor a menor las densidades
-    std::sort(d.begin(), d.end(), std::greater<Densidad>());
+    std::vector<bool> mejor = est.dentro;
+    double huecoMejor = est.hueco, valorMejor = est.valorAc;
+    const size_t tamCore = est.finCore - est.iniCore;
+    int k = 1;
+    for (int sinMejora = 0; sinMejora < maxSacudidas && tamCore > 0;) {
+        //Sacudimos y reparamos quitando los de menor densidad
+        for (int i = 0; i < k; ++i)
+            cambiaLocal(est, est.iniCore + gen() % tamCore);
+        for (size_t p = n; p-- > 0 && est.hueco < 0;)
+            if (est.dentro[p])
+                cambiaLocal(est, p);
+        descensoLocal(est);
 
-    //Cogemos los objetos mientras quepan enteros
-    valorSol = 0;
-    size_t i;
-    for (i = 0; i < n && M - objetos[d[i].obj].peso >= 0; ++i) {
-        valorSol += objetos[d[i].obj].valor;
-        M -= objetos[d[i].obj].peso;
-        solucion[d[i].obj] = 1;
+        if (est.valorAc > valorMejor + 1e-9 * std::max(1.0, valorMejor)) {
+            mejor = est.dentro;
+            huecoMejor = est.hueco;
+            valorMejor = est.valorAc;
+            k = 1;
+            sinMejora = 0;
+        } else {
+            est.dentro = mejor;
+            est.hueco = huecoMejor;
+            est.valorAc = valorMejor;
+            k = k % K_MAX_SACUDIDA + 1;
+            ++sinMejora;
+        }
     }
 
-    //Si aun no se ha llenado la mochila completamos partiendo el objeto
-    if (M > 0) {
-        solucion[d[i].obj] = M / objetos[d[i].obj].peso;
-        valorSol += objetos[d[i].obj].valor * solucion[d[i].obj];
-    }
+    for (size_t p = 0; p < n; ++p)
+        sol[est.orden[p]] = est.dentro[p];
+    valorSol = est.valorAc;
 }
 
 /**
- * Resuelve el problema de la mochila 0-1 mediante un algoritmo de
- * programacion dinamica. El peso de cada objeto y el peso maximo de la
- * mochila deben ser enteros positivos.
+ * Resuelve el problema de la mochila 0-1 mediante busqueda local a partir
+ * de la solucion voraz (la de mochilaVoraz sin el objeto fraccionado). Se
+ * desciende por los vecindarios anyadir, intercambio 1-1 y 2-1 (quitar dos
+ * y meter uno o quitar uno y meter dos) y despues se hace una busqueda de
+ * vecindario variable: se cambian k objetos al azar, se repara y se vuelve
+ * a descender, aumentando k mientras no mejore. Los intercambios se
+ * restringen al nucleo, los tamCore objetos alrededor del critico en orden
+ * de densidad. No se asegura la solucion optima.
  *
- * Coste: O(nM) en tiempo y espacio, n = numero de objetos, M = peso que
- * soporta la mochila.
+ * Coste: O(n logn + s(n + c^3)) en tiempo y O(n) en espacio, n = numero
+ * de objetos, c = tamanyo del nucleo, s = numero de sacudidas.
  *
  * @param objetos Conjunto de objetos que tenemos disponibles.
  * @param M Peso maximo que soporta la mochila.
  * @param solucion Indica si se coge el objeto o no.
  * @param valorSol Valor de la mochila con los objetos dados por solucion.
+ * @param perfil Si no es nullptr, acumula las medidas de cada fase.
+ * @param opciones Parametros de la busqueda.
  */
-void mochilaProgDin(std::vector<ObjetoInt> const &objetos, unsigned int M,
-                    std::vector<bool> &solucion, double &valorSol) {
-    const size_t n = objetos.size();
-
-    //Creamos e inicializamos a 0 la tabla con la que resolvemos el problema
-    std::vector<std::vector<double>> mochila(n + 1,
-                                             std::vector<double>(M + 1, 0));
-
-    //Rellenamos la tabla
-    //objetos[i - 1] ya que la tabla va de [1..n] y objetos va de [0, n)
-    for (size_t i = 1; i <= n; ++i) {
-        for (int j = 1; j <= M; ++j) {
-            if (objetos[i - 1].peso > j)    //Si no cabe no lo cogemos
-                mochila[i][j] = mochila[i - 1][j];
-            else    //Si cabe tomamos el maximo entre cogerlo y no cogerlo
-                mochila[i][j] =
-                        std::max(mochila[i - 1][j],
-                                 mochila[i - 1][j - objetos[i - 1].peso] +
-                                 objetos[i - 1].valor);
-        }
+void mochilaBusquedaLocal(std::vector<ObjetoReal> const &objetos, double M,
+                          std::vector<bool> &solucion, double &valorSol,
+                          Perfil *perfil,
+                          OpcionesBusquedaLocal const &opciones) {
+    EstadoLocal est;
+    {
+        MedidaAmbito medida(perfil, FASE_ORDENACION);
+        preparaLocal(objetos, M, opciones.tamCore, est);
     }
-    valorSol = mochila[n][M];
 
-    //Calculamos que objetos hemos cogido
-    for (size_t i = n; i >= 1; --i) {
-        if (mochila[i][M] == mochila[i - 1][M]) //No cogido el objeto i
-            solucion[i - 1] = false;
-        else {    //Cogido el objeto i
-            solucion[i - 1] = true;
-            M -= objetos[i - 1].peso;
-        }
-    }
+    //La solucion inicial vacia se completa con el primer descenso, que
+    // anyade en orden de densidad todo lo que cabe (la solucion voraz)
+    MedidaAmbito medida(perfil, FASE_BUSQUEDA_LOCAL);
+    std::mt19937 gen(opciones.semilla);
+    std::fill(solucion.begin(), solucion.end(), false);
+    valorSol = 0;
+    mejoraLocal(est, M, opciones.maxSacudidas, gen, solucion, valorSol);
 }
 
 /**
@@ -137,81 +1399,399 @@ const &d, double M, int k, double pesoAc, double valorAc, double &opt,
     }
 }
 
+/**
+ * Coge en sol, en orden de densidad, los objetos posteriores a k que quepan
+ * en el hueco. Es la solucion cuyo valor da calculoEst como estimacion
+ * pesimista.
+ *
+ * Coste: O(n), n = numero de objetos.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param d Densidades de los objetos ordenadas de mayor a menor.
+ * @param k Indice del ultimo objeto ya decidido.
+ * @param hueco Capacidad que le queda libre a la mochila.
+ * @param sol Solucion a completar.
+ */
+void completaVoraz(std::vector<ObjetoReal> const &objetos,
+                   std::vector<Densidad> const &d, int k, double hueco,
+                   std::vector<bool> &sol) {
+    for (size_t i = k + 1; i < objetos.size() && hueco > 0; ++i) {
+        if (objetos[d[i].obj].peso <= hueco) {
+            hueco -= objetos[d[i].obj].peso;
+            sol[d[i].obj] = true;
+        }
+    }
+}
+
 /**
  * Resuelve el problema de la mochila 0-1 mediante un algoritmo de
- * ramifiacion y poda.
+ * ramifiacion y poda. Con n <= MAX_PEQUENYA se usa mochilaPequenya.
+ *
+ * Los nodos que quedan por debajo de la mejor solucion se quitan de la
+ * cola de una vez, y las decisiones que ya no usa ningun nodo del
+ * historial, cuando la cola o el historial doblan su tamanyo. Si la cola
+ * de nodos vivos supera el limite de opciones.memoria (o se acaba la
+ * memoria) se limpia antes; si aun asi no cabe, la busqueda para y se
+ * devuelve la mejor solucion encontrada hasta entonces, que es factible
+ * pero puede no ser optima.
  *
- * Coste: O(n 2^n) en tiempo y espacio, n = numero de objetos.
+ * Coste: O(n 2^n) en tiempo y O(2^n) en espacio, n = numero de objetos.
  *
  * @param objetos Conjunto de objetos que tenemos disponibles.
  * @param M Peso maximo que soporta la mochila.
  * @param solMejor Indica si se coge el objeto o no.
  * @param valorMejor Valor de la mochila con los objetos dados por solMejor.
+ * @param nodosVisitados Nodos explorados.
+ * @param perfil Si no es nullptr, acumula las medidas de cada fase, los
+ * nodos visitados y los que se ha evitado visitar con una cota mas ajustada
+ * que la de Dantzig.
+ * @param opciones Cota optimista a usar, si se mejora la solucion inicial
+ * con busqueda local (con n > MAX_PEQUENYA) y la memoria que se puede usar.
  */
 void mochilaRamPoda(std::vector<ObjetoReal> const &objetos, double M,
                     std::vector<bool> &solMejor, double &valorMejor,
-                    long long int &nodosVisitados) {
-    Nodo X, Y;
-    std::priority_queue<Nodo> C;
+                    long long int &nodosVisitados, Perfil *perfil,
+                    OpcionesRamPoda const &opciones) {
+    ContadorMemoria *memoria = opciones.memoria;
+    PoolNodos nodos(0, memoria);
+    ColaNodos C(memoria);
+    VectorContado<Decision> historial(memoria); //Decisiones de coger un objeto
     const size_t n = objetos.size();
-    double pes;
+    double opt, pes;
     nodosVisitados = 0;
 
+    //Las instancias pequenyas se resuelven sin cola ni memoria dinamica
+    if (n <= MAX_PEQUENYA) {
+        mochilaPequenya(objetos, M, solMejor, valorMejor, nodosVisitados);
+        if (perfil)
+            perfil->nodosVisitados += nodosVisitados;
+        return;
+    }
+
     //Calculamos las densidades de cada objeto
     std::vector<Densidad> d(n);
-    for (size_t i = 0; i < n; ++i) {
-        d[i].densidad = objetos[i].valor / objetos[i].peso;
-        d[i].obj = i;    //Para saber a que objeto corresponde
+    {
+        MedidaAmbito medida(perfil, FASE_ORDENACION);
+        for (size_t i = 0; i < n; ++i) {
+            d[i].densidad = objetos[i].valor / objetos[i].peso;
+            d[i].obj = i;    //Para saber a que objeto corresponde
+        }
+
+        //Ordenamos de mayor a menor las densidades
+        std::sort(d.begin(), d.end(), std::greater<Densidad>());
     }
 
-    //Ordenamos de mayor a menor las densidades
-    std::sort(d.begin(), d.end(), std::greater<Densidad>());
+    //Sumas acumuladas en orden de densidad para las cotas mas ajustadas
+    std::vector<double> pesosAc, valoresAc;
+    if (opciones.cota != COTA_DANTZIG) {
+        pesosAc.assign(n + 1, 0);
+        valoresAc.assign(n + 1, 0);
+        for (size_t i = 0; i < n; ++i) {
+            pesosAc[i + 1] = pesosAc[i] + objetos[d[i].obj].peso;
+            valoresAc[i + 1] = valoresAc[i] + objetos[d[i].obj].valor;
+        }
+    }
 
-    //Generamos la raiz
-    Y.k = -1;   //Empezamos en -1 para que vaya de [0, n)
-    Y.pesoAc = 0;
-    Y.valorAc = 0;
-    Y.sol.resize(n, false);
-    calculoEst(objetos, d, M, Y.k, Y.pesoAc, Y.valorAc, Y.valorOpt,
-               valorMejor);
-
-    C.push(Y);
-    while (!C.empty() && C.top().valorOpt >= valorMejor) {
-        Y = C.top();
-        nodosVisitados++;
-        C.pop();
-        X.k = Y.k + 1;
-        X.sol = Y.sol;
-
-        //Si cabe probamos a meter el objeto en la mochila
-        if (Y.pesoAc + objetos[d[X.k].obj].peso <= M) {
-            X.sol[d[X.k].obj] = true;
-            X.pesoAc = Y.pesoAc + objetos[d[X.k].obj].peso;
-            X.valorAc = Y.valorAc + objetos[d[X.k].obj].valor;
-            X.valorOpt = Y.valorOpt;
-            if (X.k == n - 1) {
-                solMejor = X.sol;
-                valorMejor = X.valorAc;
-            } else {
-                C.push(X);
+    //La solucion inicial es la voraz. Empezamos en -1 para que vaya de [0, n)
+    calculoEst(objetos, d, M, -1, 0, 0, opt, valorMejor);
+    reconstruyeSolucion(historial, NINGUNO, solMejor);
+    completaVoraz(objetos, d, -1, M, solMejor);
+    if (opciones.busquedaLocal) {
+        //Partimos de la solucion voraz mejorada por busqueda local. Pocas
+        // sacudidas bastan: al sacar primero el nodo de mayor cota no se
+        // visitan menos nodos, solo se meten menos en la cola
+        EstadoLocal est;
+        OpcionesBusquedaLocal opLocal;
+        opLocal.maxSacudidas = 10;
+        std::mt19937 gen(opLocal.semilla);
+        MedidaAmbito medida(perfil, FASE_BUSQUEDA_LOCAL);
+        preparaLocal(objetos, M, opLocal.tamCore, est);
+        mejoraLocal(est, M, opLocal.maxSacudidas, gen, solMejor, valorMejor);
+    }
+    if (opciones.cota != COTA_DANTZIG)
+        opt = std::min(opt, cotaAjustada(pesosAc, valoresAc, opciones.cota,
+                                         0, M, 0));
+
+    //Si se supera el limite de memoria (o se acaba) paramos y nos quedamos
+    // con la mejor solucion, que siempre esta completa y es factible
+    try {
+        size_t raiz = nodos.nuevo();
+        nodos[raiz] = {-1, 0, 0, NINGUNO};
+        C.inserta(opt, raiz);
+        size_t tamCola = MIN_LIMPIEZA, tamHist = MIN_LIMPIEZA;
+        bool mejorado = false;  //Si ha subido valorMejor desde la ultima poda
+        while (!C.vacia() && C.claveMax() >= valorMejor) {
+            //Reservamos antes de sacar Y para que, si no cabe, no se pierdan
+            // sus hijos. Ademas de cuando no cabe, quitamos lo podado cuando
+            // la cola o el historial doblan su tamanyo desde la ultima
+            // limpieza, asi que cuesta O(1) por nodo
+            const bool cabe = reservaPaso(C, nodos, historial);
+            if (!cabe || (mejorado && C.tamanyo() >= 2 * tamCola) ||
+                historial.size() >= 2 * tamHist) {
+                MedidaAmbito medida(perfil, FASE_COLA);
+                const size_t antes = C.tamanyo() + historial.size();
+                if (mejorado)
+                    C.poda(valorMejor, nodos);
+                mejorado = false;
+                tamCola = std::max(C.tamanyo(), MIN_LIMPIEZA);
+                if (!cabe || historial.size() >= 2 * tamHist) {
+                    compactaHistorial(historial, C, nodos, memoria);
+                    tamHist = std::max(historial.size(), MIN_LIMPIEZA);
+                }
+
+                //Si no se libera al menos 1/16 no compensa seguir
+                const size_t despues = C.tamanyo() + historial.size();
+                if (!cabe && (antes - despues < antes / 16 ||
+                              !reservaPaso(C, nodos, historial)))
+                    throw std::bad_alloc();
+            }
+
+            NodoRamPoda Y;
+            double optY;
+            {
+                MedidaAmbito medida(perfil, FASE_COLA);
+                optY = C.claveMax();
+                size_t y = C.extrae();
+                Y = nodos[y];
+                nodos.libera(y);
+            }
+            nodosVisitados++;
+            const int k = Y.k + 1;
+            const size_t obj = d[k].obj;
+
+            //Si cabe probamos a meter el objeto en la mochila
+            if (Y.pesoAc + objetos[obj].peso <= M) {
+                historial.push_back({obj, Y.hist});
+                if ((size_t) k == n - 1) {
+                    if (Y.valorAc + objetos[obj].valor > valorMejor) {
+                        valorMejor = Y.valorAc + objetos[obj].valor;
+                        mejorado = true;
+                        reconstruyeSolucion(historial, historial.size() - 1,
+                                            solMejor);
+                    }
+                } else {
+                    MedidaAmbito medida(perfil, FASE_COLA);
+                    size_t x = nodos.nuevo();
+                    nodos[x] = {k, Y.pesoAc + objetos[obj].peso,
+                                Y.valorAc + objetos[obj].valor,
+                                historial.size() - 1};
+                    C.inserta(optY, x);
+                }
+            }
+
+            //Probamos a no meter el objeto en la mochila
+            {
+                MedidaAmbito medida(perfil, FASE_COTAS);
+                calculoEst(objetos, d, M, k, Y.pesoAc, Y.valorAc, opt, pes);
+                if (opciones.cota != COTA_DANTZIG) {
+                    double optAjustada = cotaAjustada(pesosAc, valoresAc,
+                                                      opciones.cota, k + 1,
+                                                      M - Y.pesoAc, Y.valorAc);
+                    if (perfil && opt >= valorMejor && optAjustada < valorMejor)
+                        perfil->nodosEvitados++;
+                    opt = std::min(opt, optAjustada);
+                }
+            }
+            if (opt >= valorMejor) {
+                if ((size_t) k == n - 1) {
+                    mejorado |= Y.valorAc > valorMejor;
+                    valorMejor = Y.valorAc;
+                    reconstruyeSolucion(historial, Y.hist, solMejor);
+                } else {
+                    MedidaAmbito medida(perfil, FASE_COLA);
+                    size_t x = nodos.nuevo();
+                    nodos[x] = {k, Y.pesoAc, Y.valorAc, Y.hist};
+                    C.inserta(opt, x);
+
+                    //La estimacion pesimista es una solucion factible
+                    if (pes > valorMejor) {
+                        valorMejor = pes;
+                        mejorado = true;
+                        reconstruyeSolucion(historial, Y.hist, solMejor);
+                        completaVoraz(objetos, d, k, M - Y.pesoAc, solMejor);
+                    }
+                }
             }
         }
+    } catch (std::bad_alloc const &) {
+        if (memoria)
+            memoria->degradaciones++;
+    }
 
-        //Probamos a no meter el objeto en la mochila
-        calculoEst(objetos, d, M, X.k, Y.pesoAc, Y.valorAc, X.valorOpt, pes);
-        if (X.valorOpt >= valorMejor) {
-            X.sol[d[X.k].obj] = false;
-            X.pesoAc = Y.pesoAc;
-            X.valorAc = Y.valorAc;
-            if (X.k == n - 1) {
-                solMejor = X.sol;
-                valorMejor = X.valorAc;
-            } else {
-                C.push(X);
-                valorMejor = std::max(valorMejor, pes);
+    if (perfil)
+        perfil->nodosVisitados += nodosVisitados;
+}
+
+/**
+ * Descompone cada objeto con c copias en objetos 0-1 que agrupan 1, 2, 4,
+ * ..., 2^(k-1) y c - (2^k - 1) copias. Cualquier cantidad entre 0 y c se
+ * puede formar cogiendo algunos de ellos. Nunca se generan mas copias de
+ * las que caben en la mochila.
+ *
+ * Coste: O(sum(log c_i)), c_i = copias del objeto i.
+ *
+ * @param objetos Objetos con multiplicidad.
+ * @param M Peso maximo que soporta la mochila.
+ * @param partes Objetos 0-1 resultantes. Se presupone vacio.
+ * @param origen Objeto del que procede cada parte.
+ * @param copias Numero de copias que agrupa cada parte.
+ */
+template<class ObjetoMult, class Objeto, class Peso>
+void descomponeObjetos(std::vector<ObjetoMult> const &objetos, Peso M,
+                       std::vector<Objeto> &partes,
+                       std::vector<size_t> &origen,
+                       std::vector<int> &copias) {
+    for (size_t i = 0; i < objetos.size(); ++i) {
+        if (objetos[i].peso > M)
+            continue;
+        int restantes = objetos[i].copias;
+        if (objetos[i].peso > 0)
+            restantes = (int) std::min<double>(restantes,
+                                               std::floor(M /
+                                                          objetos[i].peso));
+        for (int k = 1; restantes > 0; k *= 2) {
+            int c = std::min(k, restantes);
+            partes.push_back({c * objetos[i].peso, c * objetos[i].valor});
+            origen.push_back(i);
+            copias.push_back(c);
+            restantes -= c;
+        }
+    }
+}
+
+/**
+ * Resuelve el problema de la mochila acotada (de cada objeto hay un numero
+ * limitado de copias) mediante programacion dinamica. Cada objeto con c
+ * copias se descompone en O(log c) objetos 0-1 con 1, 2, 4, ... copias y se
+ * resuelve con mochilaProgDin. El peso de cada objeto y el peso maximo de
+ * la mochila deben ser enteros positivos.
+ *
+ * Coste: O(M sum(log c_i)) en tiempo y espacio, M = peso que soporta la
+ * mochila, c_i = copias del objeto i.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param cantidad Indica cuantas copias se cogen de cada objeto.
+ * @param valorSol Valor de la mochila con los objetos dados por cantidad.
+ */
+void mochilaAcotadaProgDin(std::vector<ObjetoIntMult> const &objetos,
+                           unsigned int M, std::vector<int> &cantidad,
+                           double &valorSol) {
+    std::vector<ObjetoInt> partes;
+    std::vector<size_t> origen;
+    std::vector<int> copias;
+    descomponeObjetos(objetos, (int) M, partes, origen, copias);
+
+    std::vector<bool> solucion(partes.size());
+    mochilaProgDin(partes, M, solucion, valorSol);
+
+    //Sumamos las copias de las partes cogidas de cada objeto
+    std::fill(cantidad.begin(), cantidad.end(), 0);
+    for (size_t i = 0; i < partes.size(); ++i)
+        if (solucion[i])
+            cantidad[origen[i]] += copias[i];
+}
+
+/**
+ * Resuelve el problema de la mochila acotada mediante ramificacion y poda.
+ * Usa la misma descomposicion binaria que mochilaAcotadaProgDin y resuelve
+ * con mochilaRamPoda, por lo que admite pesos reales.
+ *
+ * Coste: O(m 2^m) en tiempo y espacio, m = sum(log c_i).
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param cantidad Indica cuantas copias se cogen de cada objeto.
+ * @param valorSol Valor de la mochila con los objetos dados por cantidad.
+ * @param nodosVisitados Nodos explorados por la ramificacion y poda.
+ */
+void mochilaAcotadaRamPoda(std::vector<ObjetoRealMult> const &objetos,
+                           double M, std::vector<int> &cantidad,
+                           double &valorSol, long long int &nodosVisitados) {
+    std::vector<ObjetoReal> partes;
+    std::vector<size_t> origen;
+    std::vector<int> copias;
+    descomponeObjetos(objetos, M, partes, origen, copias);
+
+    std::fill(cantidad.begin(), cantidad.end(), 0);
+    valorSol = 0;
+    nodosVisitados = 0;
+    if (partes.empty())
+        return;
+
+    //Las partes mantienen la densidad de su objeto, asi que las cotas de
+    // mochilaRamPoda siguen siendo validas
+    std::vector<bool> solucion(partes.size());
+    mochilaRamPoda(partes, M, solucion, valorSol, nodosVisitados);
+
+    for (size_t i = 0; i < partes.size(); ++i)
+        if (solucion[i])
+            cantidad[origen[i]] += copias[i];
+}
+
+/**
+ * Resuelve el problema de la mochila ilimitada (de cada objeto hay tantas
+ * copias como se quiera) mediante programacion dinamica sobre un unico
+ * vector de capacidades. Los objetos con peso <= 0 y valor <= 0 no se
+ * cogen nunca. Si hay uno con peso <= 0 y valor > 0 la mochila no esta
+ * acotada (se puede coger infinitas veces): se muestra un error, no se coge
+ * nada y valorSol es infinito.
+ *
+ * Coste: O(nM) en tiempo y O(M) en espacio, n = numero de objetos, M = peso
+ * que soporta la mochila.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param cantidad Indica cuantas copias se cogen de cada objeto.
+ * @param valorSol Valor de la mochila con los objetos dados por cantidad.
+ */
+void mochilaIlimitada(std::vector<ObjetoInt> const &objetos, unsigned int M,
+                      std::vector<int> &cantidad, double &valorSol) {
+    const size_t n = objetos.size();
+
+    std::fill(cantidad.begin(), cantidad.end(), 0);
+    for (size_t i = 0; i < n; ++i) {
+        if (objetos[i].peso <= 0 && objetos[i].valor > 0) {
+            std::cout << "ERROR. La mochila no esta acotada: el objeto " << i
+                      << " pesa " << objetos[i].peso << " y vale "
+                      << objetos[i].valor << ".\n";
+            valorSol = std::numeric_limits<double>::infinity();
+            return;
+        }
+    }
+
+    //mochila[j] = mejor valor con peso <= j, ultimo[j] = ultimo objeto que
+    // ha mejorado mochila[j] (o n si ninguno)
+    std::vector<double> mochila(M + 1, 0);
+    std::vector<size_t> ultimo(M + 1, n);
+
+    //Recorremos las capacidades en orden creciente para poder volver a
+    // coger el mismo objeto
+    for (size_t i = 0; i < n; ++i) {
+        //Con peso <= 0 (y valor <= 0) no mejora nada y no se podria
+        // reconstruir la solucion
+        if (objetos[i].peso <= 0)
+            continue;
+        for (unsigned int j = objetos[i].peso; j <= M; ++j) {
+            if (mochila[j - objetos[i].peso] + objetos[i].valor >
+                mochila[j]) {
+                mochila[j] = mochila[j - objetos[i].peso] + objetos[i].valor;
+                ultimo[j] = i;
             }
         }
     }
+    valorSol = mochila[M];
+
+    //Calculamos cuantas copias hemos cogido de cada objeto
+    for (unsigned int j = M; ultimo[j] != n; j -= objetos[ultimo[j]].peso)
+        cantidad[ultimo[j]]++;
+}
+
+/**
+ * Numero aleatorio uniforme en [0, 1].
+ */
+static double aleatorio01(std::mt19937 &gen) {
+    return (double) gen() / (double) std::mt19937::max();
 }
 
 /**
@@ -224,9 +1804,10 @@ void mochilaRamPoda(std::vector<ObjetoReal> const &objetos, double M,
  * @param c Cromosoma a evaluar.
  * @param objetos Conjunto de objetos que tenemos disponibles.
  * @param M Peso maximo que soporta la mochila.
+ * @param gen Generador de numeros aleatorios.
  */
 void funcAptitud(Cromosoma &c, std::vector<ObjetoReal> const &objetos,
-                 double M) {
+                 double M, std::mt19937 &gen) {
     double pesoAc, valorAc;
     pesoAc = valorAc = 0;
 
@@ -239,7 +1820,7 @@ void funcAptitud(Cromosoma &c, std::vector<ObjetoReal> const &objetos,
     }
 
     //Si no cabe en la mochila, descartamos aleatoriamente hasta que quepa
-    size_t r = rand() % c.crom.size();
+    size_t r = gen() % c.crom.size();
     while (pesoAc > M) {
         if (c.crom[r]) {
             c.crom[r] = false;
@@ -259,19 +1840,20 @@ void funcAptitud(Cromosoma &c, std::vector<ObjetoReal> const &objetos,
  *
  * @param poblacion Conjunto de cromosomas.
  * @param nObjetos Numero de objetos que tenemos disponibles.
+ * @param gen Generador de numeros aleatorios.
  */
 void iniPoblacion(std::vector<Cromosoma> &poblacion,
-                  size_t nObjetos) {
+                  size_t nObjetos, std::mt19937 &gen) {
     for (Cromosoma &c : poblacion)
         for (int i = 0; i < nObjetos; ++i)
-            c.crom.push_back(rand() % 2);
+            c.crom.push_back(gen() % 2);
 }
 
 /**
  * Selecciona los individuos que formaran parte de la siguiente generacion.
- * Escoge un porcentaje (PROB_ELITISMO) de los mejores cromosomas de la
+ * Escoge un porcentaje (probElitismo) de los mejores cromosomas de la
  * generacion anterior y los mantiene. El resto se seleccionan segun su
- * aptitud dando mas posibilidades (PROB_xCUARTIL) a los mejores cromosomas.
+ * aptitud dando mas posibilidades (probxCuartil) a los mejores cromosomas.
  *
  * Coste: O(n logn), n = numero de objetos.
  *
@@ -279,9 +1861,12 @@ void iniPoblacion(std::vector<Cromosoma> &poblacion,
  * @param seleccionados Vector donde almacenaremos los individuos
  * seleccionados a formar parte de la siguiente generacion. Presuponemos que
  * ya esta creado con el mismo tamanyo que poblacion.
+ * @param config Parametros del algoritmo.
+ * @param gen Generador de numeros aleatorios.
  */
 void funcSeleccion(std::vector<Cromosoma> &poblacion,
-                   std::vector<Cromosoma> &seleccionados) {
+                   std::vector<Cromosoma> &seleccionados,
+                   ConfigGenetico const &config, std::mt19937 &gen) {
     std::vector<int> ind(poblacion.size());
     for (int i = 0; i < ind.size(); ++i)
         ind[i] = i;
@@ -292,20 +1877,20 @@ void funcSeleccion(std::vector<Cromosoma> &poblacion,
     sort(ind.begin(), ind.end(), comp);
 
     //Selecciona primero a los mejores para preservarlos (elitismo)
-    int nElit = (int) ceil(PROB_ELITISMO * n);
+    int nElit = (int) ceil(config.probElitismo * n);
     int i = 0;
     for (i; i < nElit; ++i)
         seleccionados[i] = poblacion[ind[i]];
 
     //Completa seleccionando con mayor probabilidad los cromosomas mas aptos
     for (i; i < n; ++i) {
-        double r = (double) rand() / (double) RAND_MAX; //Entre 0 y 1
-        size_t j = rand() % n / 4;  //Posicion inferior al primer cuartil
-        if (r > PROB_3CUARTIL) {    //Desplazamos la posicion a entre el
-            j += (3 * n) / 4;        // tercer cuartil y el final
-        } else if (r > PROB_2CUARTIL) { //Entre el 2 y el 3
+        double r = aleatorio01(gen);    //Entre 0 y 1
+        size_t j = gen() % n / 4;   //Posicion inferior al primer cuartil
+        if (r > config.prob3Cuartil) {  //Desplazamos la posicion a entre el
+            j += (3 * n) / 4;           // tercer cuartil y el final
+        } else if (r > config.prob2Cuartil) {   //Entre el 2 y el 3
             j += n / 2;
-        } else if (r > PROB_1CUARTIL) { //Entre el 1 y el 2
+        } else if (r > config.prob1Cuartil) {   //Entre el 1 y el 2
             j += n / 4;
         }
         seleccionados[i] = poblacion[ind[j]];
@@ -314,46 +1899,52 @@ void funcSeleccion(std::vector<Cromosoma> &poblacion,
 
 /**
  * Cruza los elementos de la poblacion usando cruce simple. Solo cruza un
- * porcentage de los elementos (PROB_CRUCE), el resto no los modifica.
+ * porcentage de los elementos (probCruce), el resto no los modifica.
  *
  * Coste: O(nm), n = numero de objetos, m = tamanyo de la poblacion.
  *
  * @param seleccionados Cromosomas seleccionados para cruzarse.
+ * @param config Parametros del algoritmo.
+ * @param gen Generador de numeros aleatorios.
  */
-void funcCruce(std::vector<Cromosoma> &seleccionados) {
+void funcCruce(std::vector<Cromosoma> &seleccionados,
+               ConfigGenetico const &config, std::mt19937 &gen) {
     //Cogemos los elementos de dos en dos
     for (size_t i = 1; i < seleccionados.size(); i += 2) {
 
-        double r = (double) rand() / (double) RAND_MAX;
-        if (r <= PROB_CRUCE) {  //Si se deben cruzar
+        double r = aleatorio01(gen);
+        if (r <= config.probCruce) {    //Si se deben cruzar
 
             //Elegimos el punto de cruce simple
-            size_t k = rand() % seleccionados[i].crom.size();
+            size_t k = gen() % seleccionados[i].crom.size();
 
             for (int j = 0; j < k; ++j)   //Cruzamos el intervalo
-                std::swap(seleccionados[i].crom[j],
-                          seleccionados[i - 1].crom[j]);
+                std::vector<bool>::swap(seleccionados[i].crom[j],
+                                        seleccionados[i - 1].crom[j]);
         }
     }
 }
 
 /**
- * Muta un porcentaje PORC_MUTACION de los elementos de cada cromosoma con
- * probabilidad PROB_MUTACION.
+ * Muta un porcentaje porcMutacion de los elementos de cada cromosoma con
+ * probabilidad probMutacion.
  *
  * Coste: O(n), n = numero de objetos.
  *
  * @param seleccionados Cromosomas seleccionados para mutar.
+ * @param config Parametros del algoritmo.
+ * @param gen Generador de numeros aleatorios.
  */
-void funcMutacion(std::vector<Cromosoma> &seleccionados) {
+void funcMutacion(std::vector<Cromosoma> &seleccionados,
+                  ConfigGenetico const &config, std::mt19937 &gen) {
     for (Cromosoma &c : seleccionados) {
-        double r = (double) rand() / (double) RAND_MAX;
-        if (r <= PROB_MUTACION) { //Si se debe mutar
+        double r = aleatorio01(gen);
+        if (r <= config.probMutacion) { //Si se debe mutar
 
-            int numMut = rand() % (int) std::ceil(c.crom.size() *
-                                                  PORC_MUTACION);
+            int numMut = gen() % (int) std::ceil(c.crom.size() *
+                                                 config.porcMutacion);
             for (int i = 0; i < numMut; ++i) {
-                size_t j = rand() % c.crom.size();
+                size_t j = gen() % c.crom.size();
                 c.crom[j] = !c.crom[j];
             }
         }
@@ -361,31 +1952,46 @@ void funcMutacion(std::vector<Cromosoma> &seleccionados) {
 }
 
 /**
- * Comprueba si se cumple alguna condicion de terminacion. Si se ha superado
- * el maximo de generaciones o si no se ha mejorado ni la media ni la mejor
- * solucion en las ultimas TAM_ULT generaciones devuelve true.
+ * Comprueba si se cumple alguna condicion de terminacion. Si se ha
+ * alcanzado el valor objetivo o el tiempo maximo (si se han fijado), si se
+ * ha superado el maximo de generaciones o si no se ha mejorado ni la media
+ * ni la mejor solucion en las ultimas tamUlt generaciones devuelve true.
  *
  * Coste: O(1).
  *
- * @param ultMedias Contiene las ultimas TAM_ULT mejores medias.
- * @param ultMejores Contiene los ultimos TAM_ULT mejores valores.
+ * @param ultMedias Contiene las ultimas tamUlt mejores medias.
+ * @param ultMejores Contiene los ultimos tamUlt mejores valores.
  * @param generacionAct Generacion por la que vamos.
+ * @param valorMejor Valor de la mejor solucion hasta el momento.
+ * @param inicio Instante en el que empezo el algoritmo.
+ * @param config Parametros del algoritmo.
  * @return True si se cumple alguna condicion de terminacion, false en caso
  * contrario.
  */
 bool condTerminacion(std::deque<double> &ultMedias,
-                     std::deque<double> &ultMejores, int generacionAct) {
+                     std::deque<double> &ultMejores, int generacionAct,
+                     double valorMejor,
+                     std::chrono::steady_clock::time_point inicio,
+                     ConfigGenetico const &config) {
+    //Si ya tenemos una solucion suficientemente buena o se acaba el tiempo
+    if (config.objetivo > 0 && valorMejor >= config.objetivo)
+        return true;
+    if (config.tiempoMax > 0 &&
+        std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                      inicio).count() >= config.tiempoMax)
+        return true;
+
     //Nunca terminamos en las primeras generaciones
-    if (generacionAct < TAM_ULT)
+    if (generacionAct < config.tamUlt)
         return false;
 
     //Si se ha superado el maximo de generaciones
-    if (generacionAct >= MAX_GENERACIONES)
+    if (generacionAct >= config.maxGeneraciones)
         return true;
 
     //Comprobamos si se ha mejorado la media o el valor mejor ultimamente
     bool mejora = false;
-    for (int i = 0; i < TAM_ULT - 1 && !mejora; ++i) {
+    for (int i = 0; i < config.tamUlt - 1 && !mejora; ++i) {
         if (ultMedias[i] > ultMedias.back() ||
             ultMejores[i] > ultMejores.back())
             mejora = true;
@@ -402,8 +2008,8 @@ bool condTerminacion(std::deque<double> &ultMedias,
  * Coste: O(n), n = numero de objetos.
  *
  * @param poblacion Conjunto de cromosomas con las aptitudes ya calculadas.
- * @param ultMedias Contiene las TAM_ULT ultimas medias.
- * @param ultMejores Contiene los TAM_ULT ultimos mejores valores.
+ * @param ultMedias Contiene las tamUlt ultimas medias.
+ * @param ultMejores Contiene los tamUlt ultimos mejores valores.
  * @param solMejor Mejor solucion hasta el momento.
  * @param valorMejor Valor de la mejor solucion hasta el momento.
  */
@@ -434,12 +2040,36 @@ void calcMejores(std::vector<Cromosoma> const &poblacion, std::deque<double>
     }
 }
 
+/**
+ * Mejora por descenso (sin sacudidas) cada cromosoma con probabilidad
+ * probBusquedaLocal y guarda en el la solucion mejorada.
+ *
+ * Coste: O(m(n + c^3)) por mejora, n = numero de objetos, m = tamanyo de la
+ * poblacion, c = tamanyo del nucleo.
+ *
+ * @param poblacion Conjunto de cromosomas ya evaluados.
+ * @param est Estado preparado con preparaLocal.
+ * @param M Peso maximo que soporta la mochila.
+ * @param config Parametros del algoritmo.
+ * @param gen Generador de numeros aleatorios.
+ */
+void funcBusquedaLocal(std::vector<Cromosoma> &poblacion, EstadoLocal &est,
+                       double M, ConfigGenetico const &config,
+                       std::mt19937 &gen) {
+    for (Cromosoma &c : poblacion)
+        if (aleatorio01(gen) < config.probBusquedaLocal)
+            mejoraLocal(est, M, 0, gen, c.crom, c.valor);
+}
+
 /**
  * Resuelve el problema de la mochila 0-1 mediante un algoritmo genetico. No
  * se asegura la solucion optima. Se suele obtener una solucion buena en un
  * tiempo razonable.
  *
- * Coste tiempo: O(nm * MAX_GENERACIONES), n = numero de objetos, m = tamanyo
+ * Con probBusquedaLocal > 0, tras evaluar cada generacion se mejora por
+ * busqueda local una parte de los cromosomas (ver mochilaBusquedaLocal).
+ *
+ * Coste tiempo: O(nm * maxGeneraciones), n = numero de objetos, m = tamanyo
  *                  de la poblacion.
  * Coste espacio: O(m)
  *
@@ -447,37 +2077,446 @@ void calcMejores(std::vector<Cromosoma> const &poblacion, std::deque<double>
  * @param M Peso maximo que soporta la mochila.
  * @param solMejor Indica si se coge el objeto o no.
  * @param valorMejor Valor de la mochila con los objetos dados por solMejor.
+ * @param perfil Si no es nullptr, acumula las medidas de cada fase.
+ * @param config Parametros del algoritmo.
  */
 void mochilaGenetico(std::vector<ObjetoReal> const &objetos, double M,
-                     std::vector<bool> &solMejor, double &valorMejor) {
+                     std::vector<bool> &solMejor, double &valorMejor,
+                     Perfil *perfil, ConfigGenetico const &config) {
+    const auto inicio = std::chrono::steady_clock::now();
+    std::mt19937 gen(config.semilla ? config.semilla : std::random_device()());
 
     //Inicializamos las estructuras
-    std::vector<Cromosoma> poblacion(TAM_POBL);
-    std::vector<Cromosoma> seleccionados(TAM_POBL);
-    std::deque<double> ultMedias(TAM_ULT);
-    std::deque<double> ultMejores(TAM_ULT);
+    std::vector<Cromosoma> poblacion(config.tamPobl);
+    std::vector<Cromosoma> seleccionados(config.tamPobl);
+    std::deque<double> ultMedias(config.tamUlt);
+    std::deque<double> ultMejores(config.tamUlt);
     valorMejor = -1;
     for (Cromosoma &c : seleccionados)
         c.crom.resize(objetos.size());
+    EstadoLocal est;
+    if (config.probBusquedaLocal > 0) {
+        MedidaAmbito medida(perfil, FASE_ORDENACION);
+        preparaLocal(objetos, M, OpcionesBusquedaLocal().tamCore, est);
+    }
 
     //Generamos la poblacion inicial y calculamos sus aptitudes
-    iniPoblacion(poblacion, objetos.size());
-    for (Cromosoma &c : poblacion)
-        funcAptitud(c, objetos, M);
+    iniPoblacion(poblacion, objetos.size(), gen);
+    {
+        MedidaAmbito medida(perfil, FASE_APTITUD);
+        for (Cromosoma &c : poblacion)
+            funcAptitud(c, objetos, M, gen);
+    }
+    if (config.probBusquedaLocal > 0) {
+        MedidaAmbito medida(perfil, FASE_BUSQUEDA_LOCAL);
+        funcBusquedaLocal(poblacion, est, M, config, gen);
+    }
     calcMejores(poblacion, ultMedias, ultMejores, solMejor, valorMejor);
 
     //Mientras que no se cumpla la condicion de terminacion vamos
     // evolucionando las sucesivas generaciones
     for (int generacionAct = 0;
-         !condTerminacion(ultMedias, ultMejores, generacionAct);
+         !condTerminacion(ultMedias, ultMejores, generacionAct, valorMejor,
+                          inicio, config);
+         generacionAct++) {
+        {
+            MedidaAmbito medida(perfil, FASE_SELECCION);
+            funcSeleccion(poblacion, seleccionados, config, gen);
+        }
+        {
+            MedidaAmbito medida(perfil, FASE_CRUCE);
+            funcCruce(seleccionados, config, gen);
+        }
+        {
+            MedidaAmbito medida(perfil, FASE_MUTACION);
+            funcMutacion(seleccionados, config, gen);
+        }
+        poblacion = seleccionados;
+        {
+            MedidaAmbito medida(perfil, FASE_APTITUD);
+            for (Cromosoma &c : poblacion)
+                funcAptitud(c, objetos, M, gen);
+        }
+        if (config.probBusquedaLocal > 0) {
+            MedidaAmbito medida(perfil, FASE_BUSQUEDA_LOCAL);
+            funcBusquedaLocal(poblacion, est, M, config, gen);
+        }
+        calcMejores(poblacion, ultMedias, ultMejores, solMejor, valorMejor);
+    }
+}
+
+struct InstanciaMultiDim {
+    size_t n, d;
+    std::vector<size_t> obj;        //Objeto original de cada posicion
+    std::vector<double> pesos;      //pesos[i * d + k], orden de densidad
+    std::vector<double> valores;
+    std::vector<double> M;
+    std::vector<double> pesosSurAc; //Sumas acumuladas de pesos subrogados
+    std::vector<double> valoresAc;  //Sumas acumuladas de valores
+    double MSur;                    //Capacidad de la restriccion subrogada
+};
+
+/**
+ * Prepara una instancia multidimensional para los algoritmos: descarta los
+ * objetos que no caben solos en la mochila, calcula los multiplicadores de
+ * la restriccion subrogada y guarda los objetos ordenados en orden
+ * decreciente de densidad subrogada en un unico vector de pesos contiguo.
+ * Los objetos con peso subrogado 0 van al principio si tienen valor y al
+ * final si no.
+ *
+ * Coste: O(dn + n logn), n = numero de objetos, d = numero de dimensiones.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila en cada dimension.
+ * @param inst Instancia preparada.
+ */
+void preparaMultiDim(std::vector<ObjetoMultiDim> const &objetos,
+                     std::vector<double> const &M, InstanciaMultiDim &inst) {
+    const size_t d = M.size();
+
+    //Solo consideramos los objetos que caben solos en la mochila
+    std::vector<size_t> validos;
+    for (size_t i = 0; i < objetos.size(); ++i) {
+        bool cabe = true;
+        for (size_t k = 0; k < d && cabe; ++k)
+            cabe = objetos[i].pesos[k] <= M[k];
+        if (cabe)
+            validos.push_back(i);
+    }
+
+    //Multiplicadores: u_k = (suma de pesos en k / M_k) / M_k, asi cada
+    // dimension pesa en proporcion a lo ajustada que esta
+    std::vector<double> u(d, 0);
+    for (size_t k = 0; k < d; ++k) {
+        if (M[k] <= 0)
+            continue;
+        double suma = 0;
+        for (size_t i : validos)
+            suma += objetos[i].pesos[k];
+        u[k] = (suma / M[k]) / M[k];
+    }
+
+    //Un objeto sin peso subrogado (pesa 0 en todas las dimensiones con
+    // multiplicador) no tiene densidad: en vez de dividir entre 0 va el
+    // primero si tiene valor y el ultimo si no
+    const size_t n = validos.size();
+    std::vector<double> pesoSur(n);
+    std::vector<Densidad> dens, primeros, ultimos;
+    dens.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        pesoSur[i] = 0;
+        for (size_t k = 0; k < d; ++k)
+            pesoSur[i] += u[k] * objetos[validos[i]].pesos[k];
+        const double valor = objetos[validos[i]].valor;
+        if (pesoSur[i] > 0)
+            dens.push_back({valor / pesoSur[i], i});
+        else if (valor > 0)
+            primeros.push_back({0, i});
+        else
+            ultimos.push_back({0, i});
+    }
+    std::sort(dens.begin(), dens.end(), std::greater<Densidad>());
+    dens.insert(dens.begin(), primeros.begin(), primeros.end());
+    dens.insert(dens.end(), ultimos.begin(), ultimos.end());
+
+    inst.n = n;
+    inst.d = d;
+    inst.M = M;
+    inst.MSur = 0;
+    for (size_t k = 0; k < d; ++k)
+        inst.MSur += u[k] * M[k];
+    inst.obj.resize(n);
+    inst.pesos.resize(n * d);
+    inst.valores.resize(n);
+    inst.pesosSurAc.assign(n + 1, 0);
+    inst.valoresAc.assign(n + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        size_t o = validos[dens[i].obj];
+        inst.obj[i] = o;
+        for (size_t k = 0; k < d; ++k)
+            inst.pesos[i * d + k] = objetos[o].pesos[k];
+        inst.valores[i] = objetos[o].valor;
+        inst.pesosSurAc[i + 1] = inst.pesosSurAc[i] + pesoSur[dens[i].obj];
+        inst.valoresAc[i + 1] = inst.valoresAc[i] + objetos[o].valor;
+    }
+}
+
+/**
+ * Calcula la cota optimista en la version multidimensional: la solucion
+ * voraz fraccionada de la restriccion subrogada con los objetos que quedan
+ * por decidir. Es la extension de calculoEst a varias dimensiones.
+ *
+ * Coste: O(log n), n = numero de objetos.
+ *
+ * @param inst Instancia preparada con preparaMultiDim.
+ * @param k Indice del objeto por el que vamos.
+ * @param pesoSurAc Peso subrogado acumulado en la mochila.
+ * @param valorAc Valor acumulado en la mochila.
+ * @return Cota optimista.
+ */
+double calculoEstMultiDim(InstanciaMultiDim const &inst, int k,
+                          double pesoSurAc, double valorAc) {
+    return cotaVorazAcumulada(inst.pesosSurAc, inst.valoresAc, k + 1,
+                              std::max(0.0, inst.MSur - pesoSurAc), valorAc);
+}
+
+/**
+ * Comprueba si el objeto i cabe en la mochila en todas las dimensiones.
+ *
+ * Coste: O(d), d = numero de dimensiones.
+ *
+ * @param inst Instancia preparada con preparaMultiDim.
+ * @param i Posicion del objeto (en orden de densidad).
+ * @param pesoAc Peso acumulado en cada dimension.
+ * @return True si cabe, false en caso contrario.
+ */
+inline bool cabeMultiDim(InstanciaMultiDim const &inst, size_t i,
+                         double const *pesoAc) {
+    double const *p = &inst.pesos[i * inst.d];
+    bool cabe = true;
+    for (size_t k = 0; k < inst.d; ++k)
+        cabe &= pesoAc[k] + p[k] <= inst.M[k];
+    return cabe;
+}
+
+/**
+ * Mete (signo = 1) o saca (signo = -1) el objeto i de la mochila.
+ *
+ * Coste: O(d), d = numero de dimensiones.
+ */
+inline void sumaMultiDim(InstanciaMultiDim const &inst, size_t i,
+                         double *pesoAc, double signo) {
+    double const *p = &inst.pesos[i * inst.d];
+    for (size_t k = 0; k < inst.d; ++k)
+        pesoAc[k] += signo * p[k];
+}
+
+/**
+ * Resuelve el problema de la mochila 0-1 multidimensional (cada objeto
+ * tiene d pesos y la mochila d capacidades) mediante ramificacion y poda.
+ * La cota optimista es la voraz fraccionada de la restriccion subrogada
+ * sum_k(u_k peso_k) <= sum_k(u_k M_k), con u_k mayor cuanto mas ajustada
+ * es la dimension k.
+ *
+ * Coste: O(d n 2^n) en tiempo y O(d 2^n) en espacio, n = numero de
+ * objetos, d = numero de dimensiones.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila en cada dimension.
+ * @param solMejor Indica si se coge el objeto o no.
+ * @param valorMejor Valor de la mochila con los objetos dados por solMejor.
+ * @param nodosVisitados Nodos explorados.
+ * @param limiteNodos Si es mayor que 0, se devuelve la mejor solucion
+ * encontrada tras explorar ese numero de nodos (puede no ser la optima).
+ * Con 0, el valor por defecto, no hay limite: se explora hasta demostrar
+ * la optima, con el coste del peor caso.
+ */
+void mochilaMultiDimRamPoda(std::vector<ObjetoMultiDim> const &objetos,
+                            std::vector<double> const &M,
+                            std::vector<bool> &solMejor, double &valorMejor,
+                            long long int &nodosVisitados,
+                            long long int limiteNodos) {
+    InstanciaMultiDim inst;
+    preparaMultiDim(objetos, M, inst);
+    const size_t n = inst.n, d = inst.d;
+    nodosVisitados = 0;
+
+    //Solucion voraz (respetando todas las dimensiones) como mejor inicial
+    std::fill(solMejor.begin(), solMejor.end(), false);
+    std::vector<double> carga(d, 0);
+    valorMejor = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (cabeMultiDim(inst, i, carga.data())) {
+            sumaMultiDim(inst, i, carga.data(), 1);
+            valorMejor += inst.valores[i];
+            solMejor[inst.obj[i]] = true;
+        }
+    }
+    if (n == 0)
+        return;
+
+    //Cada nodo guarda en su zona extra el peso acumulado en cada dimension
+    PoolNodos nodos(d);
+    ColaNodos C;
+    std::vector<Decision> historial;    //Decisiones de coger un objeto
+    std::vector<double> pesoAcY(d);     //Peso por dimension del nodo extraido
+
+    //Generamos la raiz. pesoAc guarda el peso subrogado acumulado
+    size_t raiz = nodos.nuevo();
+    nodos[raiz] = {-1, 0, 0, NINGUNO};
+    std::fill(nodos.extra(raiz), nodos.extra(raiz) + d, 0);
+    C.inserta(calculoEstMultiDim(inst, -1, 0, 0), raiz);
+
+    while (!C.vacia() && C.claveMax() >= valorMejor &&
+           (limiteNodos <= 0 || nodosVisitados < limiteNodos)) {
+        const double optY = C.claveMax();
+        const size_t y = C.extrae();
+        const NodoRamPoda Y = nodos[y];
+        std::copy(nodos.extra(y), nodos.extra(y) + d, pesoAcY.begin());
+        nodos.libera(y);
+        nodosVisitados++;
+        const int k = Y.k + 1;
+        const double pesoSur = inst.pesosSurAc[k + 1] - inst.pesosSurAc[k];
+
+        //Si cabe en todas las dimensiones probamos a meterlo
+        if (cabeMultiDim(inst, k, pesoAcY.data())) {
+            const double valorAc = Y.valorAc + inst.valores[k];
+            historial.push_back({inst.obj[k], Y.hist});
+            if ((size_t) k == n - 1) {
+                if (valorAc > valorMejor) {
+                    valorMejor = valorAc;
+                    reconstruyeSolucion(historial, historial.size() - 1,
+                                        solMejor);
+                }
+            } else {
+                size_t x = nodos.nuevo();
+                nodos[x] = {k, Y.pesoAc + pesoSur, valorAc,
+                            historial.size() - 1};
+                double *pesoAcX = nodos.extra(x);
+                std::copy(pesoAcY.begin(), pesoAcY.end(), pesoAcX);
+                sumaMultiDim(inst, k, pesoAcX, 1);
+                C.inserta(optY, x);
+            }
+        }
+
+        //Probamos a no meter el objeto en la mochila
+        double opt = calculoEstMultiDim(inst, k, Y.pesoAc, Y.valorAc);
+        if (opt >= valorMejor) {
+            if ((size_t) k == n - 1) {
+                if (Y.valorAc > valorMejor) {
+                    valorMejor = Y.valorAc;
+                    reconstruyeSolucion(historial, Y.hist, solMejor);
+                }
+            } else {
+                size_t x = nodos.nuevo();
+                nodos[x] = {k, Y.pesoAc, Y.valorAc, Y.hist};
+                std::copy(pesoAcY.begin(), pesoAcY.end(), nodos.extra(x));
+                C.inserta(opt, x);
+            }
+        }
+    }
+}
+
+/**
+ * Calcula la aptitud de un cromosoma en la version multidimensional. Si no
+ * cabe en alguna dimension se quitan los objetos de menor densidad hasta
+ * que quepa, y despues se anyaden los de mayor densidad que quepan. El
+ * cromosoma esta indexado en orden de densidad.
+ *
+ * Coste: O(dn), n = numero de objetos, d = numero de dimensiones.
+ *
+ * @param c Cromosoma a evaluar.
+ * @param inst Instancia preparada con preparaMultiDim.
+ * @param carga Vector auxiliar de tamanyo d.
+ */
+void funcAptitudMultiDim(Cromosoma &c, InstanciaMultiDim const &inst,
+                         std::vector<double> &carga) {
+    const size_t n = inst.n, d = inst.d;
+    std::fill(carga.begin(), carga.end(), 0);
+    double valorAc = 0;
+
+    //Calculamos lo que tenemos en la mochila en cada dimension
+    for (size_t i = 0; i < n; ++i) {
+        if (c.crom[i]) {
+            sumaMultiDim(inst, i, carga.data(), 1);
+            valorAc += inst.valores[i];
+        }
+    }
+
+    //Quitamos los de menor densidad mientras no quepa en alguna dimension
+    auto excede = [&]() {
+        bool ex = false;
+        for (size_t k = 0; k < d; ++k)
+            ex |= carga[k] > inst.M[k];
+        return ex;
+    };
+    bool ex = excede();
+    for (size_t i = n; i-- > 0 && ex;) {
+        if (c.crom[i]) {
+            c.crom[i] = false;
+            sumaMultiDim(inst, i, carga.data(), -1);
+            valorAc -= inst.valores[i];
+            ex = excede();
+        }
+    }
+
+    //Completamos con los de mayor densidad que quepan
+    for (size_t i = 0; i < n; ++i) {
+        if (!c.crom[i] && cabeMultiDim(inst, i, carga.data())) {
+            c.crom[i] = true;
+            sumaMultiDim(inst, i, carga.data(), 1);
+            valorAc += inst.valores[i];
+        }
+    }
+
+    c.valor = valorAc;
+}
+
+/**
+ * Resuelve el problema de la mochila 0-1 multidimensional mediante un
+ * algoritmo genetico. Los cromosomas que no caben se reparan quitando los
+ * objetos de menor densidad subrogada y se completan con los de mayor
+ * densidad que quepan.
+ *
+ * Coste tiempo: O(dnm * maxGeneraciones), n = numero de objetos, m =
+ *                  tamanyo de la poblacion, d = numero de dimensiones.
+ * Coste espacio: O(dn + nm)
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila en cada dimension.
+ * @param solMejor Indica si se coge el objeto o no.
+ * @param valorMejor Valor de la mochila con los objetos dados por solMejor.
+ * @param config Parametros del algoritmo.
+ */
+void mochilaMultiDimGenetico(std::vector<ObjetoMultiDim> const &objetos,
+                             std::vector<double> const &M,
+                             std::vector<bool> &solMejor, double &valorMejor,
+                             ConfigGenetico const &config) {
+    const auto inicio = std::chrono::steady_clock::now();
+    std::mt19937 gen(config.semilla ? config.semilla : std::random_device()());
+    InstanciaMultiDim inst;
+    preparaMultiDim(objetos, M, inst);
+    const size_t n = inst.n;
+    std::fill(solMejor.begin(), solMejor.end(), false);
+    valorMejor = 0;
+    if (n == 0)
+        return;
+
+    //Inicializamos las estructuras. Los cromosomas van en orden de densidad
+    std::vector<Cromosoma> poblacion(config.tamPobl);
+    std::vector<Cromosoma> seleccionados(config.tamPobl);
+    std::deque<double> ultMedias(config.tamUlt);
+    std::deque<double> ultMejores(config.tamUlt);
+    std::vector<bool> solOrd(n);
+    std::vector<double> carga(inst.d);
+    double valorOrd = -1;
+    for (Cromosoma &c : seleccionados)
+        c.crom.resize(n);
+
+    //Generamos la poblacion inicial y calculamos sus aptitudes
+    iniPoblacion(poblacion, n, gen);
+    for (Cromosoma &c : poblacion)
+        funcAptitudMultiDim(c, inst, carga);
+    calcMejores(poblacion, ultMedias, ultMejores, solOrd, valorOrd);
+
+    //Mientras que no se cumpla la condicion de terminacion vamos
+    // evolucionando las sucesivas generaciones
+    for (int generacionAct = 0;
+         !condTerminacion(ultMedias, ultMejores, generacionAct, valorOrd,
+                          inicio, config);
          generacionAct++) {
 
-        funcSeleccion(poblacion, seleccionados);
-        funcCruce(seleccionados);
-        funcMutacion(seleccionados);
+        funcSeleccion(poblacion, seleccionados, config, gen);
+        funcCruce(seleccionados, config, gen);
+        funcMutacion(seleccionados, config, gen);
         poblacion = seleccionados;
         for (Cromosoma &c : poblacion)
-            funcAptitud(c, objetos, M);
-        calcMejores(poblacion, ultMedias, ultMejores, solMejor, valorMejor);
+            funcAptitudMultiDim(c, inst, carga);
+        calcMejores(poblacion, ultMedias, ultMejores, solOrd, valorOrd);
     }
-}
\ No newline at end of file
+
+    //Pasamos la solucion al orden original de los objetos
+    valorMejor = valorOrd;
+    for (size_t i = 0; i < n; ++i)
+        solMejor[inst.obj[i]] = solOrd[i];
+}
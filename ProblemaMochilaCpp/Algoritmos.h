@@ -4,6 +4,10 @@
 #include <vector>
 #include <iostream>
 
+#include "Memoria.h"
+#include "Perfil.h"
+#include "Solucion.h"
+
 struct ObjetoReal {
     double peso;
     double valor;
@@ -33,51 +37,352 @@ inline bool operator>(Densidad const &d1, Densidad const &d2) {
  * @param M Peso maximo que soporta la mochila.
  * @param solucion Indica cuanto se debe coger de cada objeto [0, 1].
  * @param valorSol Valor de la mochila con los objetos dados por solucion.
+ * @param perfil Si no es nullptr, acumula las medidas de cada fase.
+ */
+void mochilaVoraz(std::vector<ObjetoReal> const &objetos, double M,
+                  std::vector<double> &solucion, double &valorSol,
+                  Perfil *perfil = nullptr);
+
+/**
+ * Igual que la anterior pero devuelve la solucion dispersa: los objetos
+ * cogidos enteros, ordenados, y el objeto partido. No se reserva ni se
+ * pone a cero ningun vector de n posiciones para la solucion, y en lugar
+ * de ordenar todas las densidades se busca el objeto critico partiendo
+ * por la mediana (nth_element), asi que solo se ordenan los cogidos. Con
+ * densidades repetidas puede coger otros objetos que la anterior, con el
+ * mismo valor.
+ *
+ * Coste en tiempo: O(n + k logk) en promedio, n = numero de objetos,
+ * k = numero de objetos cogidos.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param solucion Objetos que se cogen y cuanto del objeto partido.
+ * @param valorSol Valor de la mochila con los objetos dados por solucion.
+ * @param perfil Si no es nullptr, acumula las medidas de cada fase.
  */
 void mochilaVoraz(std::vector<ObjetoReal> const &objetos, double M,
-                  std::vector<double> &solucion, double &valorSol);
+                  SolucionDispersa &solucion, double &valorSol,
+                  Perfil *perfil = nullptr);
+
+struct OpcionesProgDin {
+    //Bytes de la matriz de decisiones a partir de los que se guarda en un
+    // fichero proyectado en memoria
+    size_t maxBytesMemoria = (size_t) 1 << 30;
+    //Objetos que se aplican en cada pasada por la fila (1 = uno por pasada)
+    int objetosPorBloque = 8;
+    //Si no es nullptr, donde se anota la memoria y su limite
+    ContadorMemoria *memoria = nullptr;
+};
 
 /**
  * Resuelve el problema de la mochila 0-1 mediante un algoritmo de
  * programacion dinamica. El peso de cada objeto y el peso maximo de la
- * mochila deben ser enteros positivos.
+ * mochila deben ser enteros positivos. Si el valor de los objetos es
+ * proporcional a su peso se resuelve con mochilaSumaSubconjuntos.
+ *
+ * Solo se guarda una fila de valores y, para reconstruir la solucion, una
+ * matriz de bits con la decision (coger o no) de cada objeto y capacidad.
+ * Si la matriz ocupa mas de opciones.maxBytesMemoria se guarda en un
+ * fichero temporal proyectado en memoria. Cuando la fila no cabe en la
+ * cache, cada pasada por ella aplica hasta opciones.objetosPorBloque
+ * objetos de peso parecido por teselas (ver avanzaBloque), asi que se lee
+ * de memoria muchas menos veces.
+ *
+ * Con limite en opciones.memoria, si la matriz no cabe junto a la fila se
+ * guarda en el fichero (una degradacion), y si los anillos de un bloque no
+ * caben se aplican menos objetos por pasada, hasta uno (otra). Si ni la
+ * fila cabe se muestra un error y se devuelve la mochila vacia.
  *
- * Coste: O(nM) en tiempo y espacio, n = numero de objetos, M = peso que
- * soporta la mochila.
+ * Coste: O(nM) en tiempo, O(M) valores y nM bits en espacio, n = numero
+ * de objetos, M = peso que soporta la mochila.
  *
  * @param objetos Conjunto de objetos que tenemos disponibles.
  * @param M Peso maximo que soporta la mochila.
  * @param solucion Indica si se coge el objeto o no.
  * @param valorSol Valor de la mochila con los objetos dados por solucion.
+ * @param perfil Si no es nullptr, acumula las medidas de cada fase.
+ * @param opciones Donde se guarda la matriz de decisiones, cuantos
+ * objetos se aplican en cada pasada y la memoria que se puede usar.
  */
 void mochilaProgDin(std::vector<ObjetoInt> const &objetos, unsigned int M,
+                    std::vector<bool> &solucion, double &valorSol,
+                    Perfil *perfil = nullptr,
+                    OpcionesProgDin const &opciones = OpcionesProgDin());
+
+/**
+ * Indica si el valor de todos los objetos es proporcional a su peso, es
+ * decir, valor = c * peso con c > 0 la misma constante para todos (por
+ * ejemplo, suma de subconjuntos con c = 1).
+ *
+ * Coste: O(n), n = numero de objetos.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @return Si la proporcion valor / peso es la misma en todos los objetos.
+ */
+bool proporcionConstante(std::vector<ObjetoInt> const &objetos);
+
+/**
+ * Resuelve el problema de la mochila 0-1 cuando el valor de cada objeto es
+ * proporcional a su peso (ver proporcionConstante). Maximizar el valor es
+ * entonces maximizar el peso, asi que basta con saber que pesos se pueden
+ * alcanzar. Los pesos alcanzables se guardan en un conjunto de bits y cada
+ * objeto se procesa con un desplazamiento y un OR por palabras de 64 bits,
+ * en lugar de una fila de doubles. Para reconstruir la solucion se guarda,
+ * para cada peso, el primer objeto con el que se alcanzo.
+ *
+ * Coste: O(nM / 64 + M) en tiempo y O(M) en espacio, n = numero de objetos,
+ * M = peso que soporta la mochila.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param solucion Indica si se coge el objeto o no.
+ * @param valorSol Valor de la mochila con los objetos dados por solucion.
+ */
+void mochilaSumaSubconjuntos(std::vector<ObjetoInt> const &objetos,
+                             unsigned int M, std::vector<bool> &solucion,
+                             double &valorSol);
+
+struct Estado {
+    double peso;
+    double valor;
+    size_t hist;    //Indice en el historial de decisiones (o NINGUNO)
+};
+
+struct Decision {
+    size_t obj;     //Objeto cogido
+    size_t padre;   //Decision anterior en el historial (o NINGUNO)
+};
+
+/**
+ * Resuelve el problema de la mochila 0-1 mediante programacion dinamica
+ * dispersa (Nemhauser-Ullmann). En lugar de una tabla indexada por la
+ * capacidad se mantiene solo la lista de estados (peso, valor) no
+ * dominados, ordenada por peso creciente. Admite pesos reales y valores de M
+ * arbitrariamente grandes. Ademas se descartan los estados cuya cota
+ * optimista (voraz fraccionada) no supera la mejor solucion conocida.
+ *
+ * Coste: O(n L) en tiempo y espacio, n = numero de objetos, L = tamanyo
+ * maximo de la lista de estados no dominados (en el peor caso 2^n, en
+ * instancias aleatorias tipicas mucho menor que M).
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param solucion Indica si se coge el objeto o no.
+ * @param valorSol Valor de la mochila con los objetos dados por solucion.
+ */
+void mochilaProgDinDispersa(std::vector<ObjetoReal> const &objetos, double M,
+                            std::vector<bool> &solucion, double &valorSol);
+
+/**
+ * Resuelve el problema de la mochila 0-1 mediante el algoritmo de
+ * Horowitz-Sahni (encuentro en el medio). Se enumeran los subconjuntos de
+ * cada mitad de los objetos (cada mitad en un hilo) en listas ordenadas por
+ * peso y sin estados dominados, y se combinan con un unico recorrido de dos
+ * punteros. Admite pesos reales y M arbitrariamente grande y su coste no
+ * depende de la correlacion entre pesos y valores. Con n > 64 las listas
+ * podrian no caber en memoria, asi que se resuelve con
+ * mochilaProgDinDispersa.
+ *
+ * Coste: O(n 2^(n/2)) en tiempo y O(2^(n/2)) en espacio con n <= 64, n =
+ * numero de objetos.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param solucion Indica si se coge el objeto o no.
+ * @param valorSol Valor de la mochila con los objetos dados por solucion.
+ */
+void mochilaMitades(std::vector<ObjetoReal> const &objetos, double M,
                     std::vector<bool> &solucion, double &valorSol);
 
-struct Nodo {
-    std::vector<bool> sol;
-    int k;
-    double pesoAc, valorAc;
-    double valorOpt;    //Prioridad
+/**
+ * Resuelve el problema de la mochila 0-1 mediante programacion dinamica
+ * indexada por el valor: para cada valor alcanzable se guarda el minimo
+ * peso necesario para conseguirlo. Los valores de los objetos deben ser
+ * enteros no negativos; los pesos y M pueden ser reales y tan grandes como
+ * se quiera.
+ *
+ * Coste: O(nV) en tiempo, O(V) en memoria para los pesos y nV bits para las
+ * decisiones, n = numero de objetos, V = suma de los valores.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param solucion Indica si se coge el objeto o no.
+ * @param valorSol Valor de la mochila con los objetos dados por solucion.
+ */
+void mochilaProgDinValor(std::vector<ObjetoReal> const &objetos, double M,
+                         std::vector<bool> &solucion, double &valorSol);
+
+/**
+ * Resuelve el problema de la mochila 0-1 de forma aproximada (FPTAS).
+ * Escala los valores por K = epsilon * vMax / n, los redondea hacia abajo y
+ * resuelve el problema escalado con mochilaProgDinValor. Se garantiza que
+ * valorSol >= (1 - epsilon) * optimo. Cuanto menor es epsilon mas precisa
+ * y mas lenta es la resolucion.
+ *
+ * Coste: O(n^3 / epsilon) en tiempo, n = numero de objetos.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param epsilon Error relativo maximo admitido, en (0, 1).
+ * @param solucion Indica si se coge el objeto o no.
+ * @param valorSol Valor de la mochila con los objetos dados por solucion.
+ */
+void mochilaFPTAS(std::vector<ObjetoReal> const &objetos, double M,
+                  double epsilon, std::vector<bool> &solucion,
+                  double &valorSol);
+
+struct OpcionesBusquedaLocal {
+    size_t tamCore = 20;        //Objetos alrededor del critico (intercambios)
+    int maxSacudidas = 100;     //Sacudidas seguidas sin mejora (0 = descenso)
+    unsigned int semilla = 1;
 };
 
-inline bool operator<(Nodo const &n1, Nodo const &n2) {
-    return n1.valorOpt < n2.valorOpt;
-}
+/**
+ * Resuelve el problema de la mochila 0-1 mediante busqueda local a partir
+ * de la solucion voraz (la de mochilaVoraz sin el objeto fraccionado). Se
+ * desciende por los vecindarios anyadir, intercambio 1-1 y 2-1 (quitar dos
+ * y meter uno o quitar uno y meter dos) y despues se hace una busqueda de
+ * vecindario variable: se cambian k objetos al azar, se repara y se vuelve
+ * a descender, aumentando k mientras no mejore. Los intercambios se
+ * restringen al nucleo, los tamCore objetos alrededor del critico en orden
+ * de densidad. No se asegura la solucion optima.
+ *
+ * Coste: O(n logn + s(n + c^3)) en tiempo y O(n) en espacio, n = numero
+ * de objetos, c = tamanyo del nucleo, s = numero de sacudidas.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param solucion Indica si se coge el objeto o no.
+ * @param valorSol Valor de la mochila con los objetos dados por solucion.
+ * @param perfil Si no es nullptr, acumula las medidas de cada fase.
+ * @param opciones Parametros de la busqueda.
+ */
+void mochilaBusquedaLocal(std::vector<ObjetoReal> const &objetos, double M,
+                          std::vector<bool> &solucion, double &valorSol,
+                          Perfil *perfil = nullptr,
+                          OpcionesBusquedaLocal const &opciones =
+                          OpcionesBusquedaLocal());
+
+/*
+ * Cotas optimistas de la ramificacion y poda, de menos a mas ajustadas. El
+ * objeto critico es el primero (en orden de densidad) que ya no cabe entero.
+ *  - COTA_DANTZIG: solucion voraz fraccionando el objeto critico.
+ *  - COTA_MARTELLO_TOTH: U2 de Martello y Toth, el maximo entre no coger el
+ *    objeto critico (llenando el hueco con la densidad del siguiente) y
+ *    cogerlo (quitando el peso que sobra con la densidad del anterior).
+ *  - COTA_CRITICO: se ramifica sobre el objeto critico y se toma la mayor
+ *    de las cotas de Dantzig de las dos ramas.
+ */
+enum TipoCota {
+    COTA_DANTZIG,
+    COTA_MARTELLO_TOTH,
+    COTA_CRITICO
+};
+
+struct OpcionesRamPoda {
+    TipoCota cota = COTA_DANTZIG;
+    bool busquedaLocal = false;     //Mejor solucion inicial por busq. local
+    //Si no es nullptr, donde se anota la memoria de la cola y su limite
+    ContadorMemoria *memoria = nullptr;
+};
 
 /**
  * Resuelve el problema de la mochila 0-1 mediante un algoritmo de
- * ramifiacion y poda.
+ * ramifiacion y poda. Con n <= MAX_PEQUENYA se usa mochilaPequenya.
+ *
+ * Los nodos que quedan por debajo de la mejor solucion se quitan de la
+ * cola de una vez, y las decisiones que ya no usa ningun nodo del
+ * historial, cuando la cola o el historial doblan su tamanyo. Si la cola
+ * de nodos vivos supera el limite de opciones.memoria (o se acaba la
+ * memoria) se limpia antes; si aun asi no cabe, la busqueda para y se
+ * devuelve la mejor solucion encontrada hasta entonces, que es factible
+ * pero puede no ser optima.
  *
- * Coste: O(n 2^n) en tiempo y espacio, n = numero de objetos.
+ * Coste: O(n 2^n) en tiempo y O(2^n) en espacio, n = numero de objetos.
  *
  * @param objetos Conjunto de objetos que tenemos disponibles.
  * @param M Peso maximo que soporta la mochila.
  * @param solMejor Indica si se coge el objeto o no.
  * @param valorMejor Valor de la mochila con los objetos dados por solMejor.
+ * @param nodosVisitados Nodos explorados.
+ * @param perfil Si no es nullptr, acumula las medidas de cada fase, los
+ * nodos visitados y los que se ha evitado visitar con una cota mas ajustada
+ * que la de Dantzig.
+ * @param opciones Cota optimista a usar, si se mejora la solucion inicial
+ * con busqueda local (con n > MAX_PEQUENYA) y la memoria que se puede usar.
  */
 void mochilaRamPoda(std::vector<ObjetoReal> const &objetos, double M,
                     std::vector<bool> &solMejor, double &valorMejor,
-                    long long int &nodosVisitados);
+                    long long int &nodosVisitados, Perfil *perfil = nullptr,
+                    OpcionesRamPoda const &opciones = OpcionesRamPoda());
+
+struct ObjetoIntMult {
+    int peso;
+    double valor;
+    int copias;     //Numero maximo de copias disponibles del objeto
+};
+
+struct ObjetoRealMult {
+    double peso;
+    double valor;
+    int copias;     //Numero maximo de copias disponibles del objeto
+};
+
+/**
+ * Resuelve el problema de la mochila acotada (de cada objeto hay un numero
+ * limitado de copias) mediante programacion dinamica. Cada objeto con c
+ * copias se descompone en O(log c) objetos 0-1 con 1, 2, 4, ... copias y se
+ * resuelve con mochilaProgDin. El peso de cada objeto y el peso maximo de
+ * la mochila deben ser enteros positivos.
+ *
+ * Coste: O(M sum(log c_i)) en tiempo y espacio, M = peso que soporta la
+ * mochila, c_i = copias del objeto i.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param cantidad Indica cuantas copias se cogen de cada objeto.
+ * @param valorSol Valor de la mochila con los objetos dados por cantidad.
+ */
+void mochilaAcotadaProgDin(std::vector<ObjetoIntMult> const &objetos,
+                           unsigned int M, std::vector<int> &cantidad,
+                           double &valorSol);
+
+/**
+ * Resuelve el problema de la mochila acotada mediante ramificacion y poda.
+ * Usa la misma descomposicion binaria que mochilaAcotadaProgDin y resuelve
+ * con mochilaRamPoda, por lo que admite pesos reales.
+ *
+ * Coste: O(m 2^m) en tiempo y espacio, m = sum(log c_i).
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param cantidad Indica cuantas copias se cogen de cada objeto.
+ * @param valorSol Valor de la mochila con los objetos dados por cantidad.
+ * @param nodosVisitados Nodos explorados por la ramificacion y poda.
+ */
+void mochilaAcotadaRamPoda(std::vector<ObjetoRealMult> const &objetos,
+                           double M, std::vector<int> &cantidad,
+                           double &valorSol, long long int &nodosVisitados);
+
+/**
+ * Resuelve el problema de la mochila ilimitada (de cada objeto hay tantas
+ * copias como se quiera) mediante programacion dinamica sobre un unico
+ * vector de capacidades. Los objetos con peso <= 0 y valor <= 0 no se
+ * cogen nunca. Si hay uno con peso <= 0 y valor > 0 la mochila no esta
+ * acotada (se puede coger infinitas veces): se muestra un error, no se coge
+ * nada y valorSol es infinito.
+ *
+ * Coste: O(nM) en tiempo y O(M) en espacio, n = numero de objetos, M = peso
+ * que soporta la mochila.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param cantidad Indica cuantas copias se cogen de cada objeto.
+ * @param valorSol Valor de la mochila con los objetos dados por cantidad.
+ */
+void mochilaIlimitada(std::vector<ObjetoInt> const &objetos, unsigned int M,
+                      std::vector<int> &cantidad, double &valorSol);
 
 struct Cromosoma {
     std::vector<bool> crom;
@@ -100,23 +405,36 @@ struct IndCompValor {
     }
 };
 
-static int MAX_GENERACIONES = 1000;
-static int TAM_POBL = 100;
-static int TAM_ULT = 10;
-static double PROB_MUTACION = 0.05;
-static double PORC_MUTACION = 0.01;
-static double PROB_CRUCE = 0.85;
-static double PROB_ELITISMO = 0.1;
-static double PROB_1CUARTIL = 0.5;
-static double PROB_2CUARTIL = 0.8;
-static double PROB_3CUARTIL = 0.95;
+/*
+ * Parametros del algoritmo genetico. Se pasan en cada llamada, asi que cada
+ * ejecucion (o cada hilo) puede usar los suyos.
+ */
+struct ConfigGenetico {
+    int maxGeneraciones = 1000;
+    int tamPobl = 100;
+    int tamUlt = 10;            //Generaciones sin mejora para terminar
+    double probMutacion = 0.05;
+    double porcMutacion = 0.01;
+    double probCruce = 0.85;
+    double probElitismo = 0.1;
+    double probBusquedaLocal = 0;   //Prob. de mejorar un hijo por busq. local
+    double prob1Cuartil = 0.5;
+    double prob2Cuartil = 0.8;
+    double prob3Cuartil = 0.95;
+    unsigned int semilla = 0;   //0 = semilla aleatoria
+    double objetivo = 0;        //Si > 0, se termina al alcanzar este valor
+    double tiempoMax = 0;       //Si > 0, se termina tras estos segundos
+};
 
 /**
  * Resuelve el problema de la mochila 0-1 mediante un algoritmo genetico. No
  * se asegura la solucion optima. Se suele obtener una solucion buena en un
  * tiempo razonable.
  *
- * Coste tiempo: O(nm * MAX_GENERACIONES), n = numero de objetos, m = tamanyo
+ * Con probBusquedaLocal > 0, tras evaluar cada generacion se mejora por
+ * busqueda local una parte de los cromosomas (ver mochilaBusquedaLocal).
+ *
+ * Coste tiempo: O(nm * maxGeneraciones), n = numero de objetos, m = tamanyo
  *                  de la poblacion.
  * Coste espacio: O(m)
  *
@@ -124,8 +442,64 @@ static double PROB_3CUARTIL = 0.95;
  * @param M Peso maximo que soporta la mochila.
  * @param solMejor Indica si se coge el objeto o no.
  * @param valorMejor Valor de la mochila con los objetos dados por solMejor.
+ * @param perfil Si no es nullptr, acumula las medidas de cada fase.
+ * @param config Parametros del algoritmo.
  */
 void mochilaGenetico(std::vector<ObjetoReal> const &objetos, double M,
-                     std::vector<bool> &solMejor, double &valorMejor);
+                     std::vector<bool> &solMejor, double &valorMejor,
+                     Perfil *perfil = nullptr,
+                     ConfigGenetico const &config = ConfigGenetico());
+
+struct ObjetoMultiDim {
+    std::vector<double> pesos;  //Un peso por cada dimension
+    double valor;
+};
+
+/**
+ * Resuelve el problema de la mochila 0-1 multidimensional (cada objeto
+ * tiene d pesos y la mochila d capacidades) mediante ramificacion y poda.
+ * La cota optimista es la voraz fraccionada de la restriccion subrogada
+ * sum_k(u_k peso_k) <= sum_k(u_k M_k), con u_k mayor cuanto mas ajustada
+ * es la dimension k.
+ *
+ * Coste: O(d n 2^n) en tiempo y O(d 2^n) en espacio, n = numero de
+ * objetos, d = numero de dimensiones.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila en cada dimension.
+ * @param solMejor Indica si se coge el objeto o no.
+ * @param valorMejor Valor de la mochila con los objetos dados por solMejor.
+ * @param nodosVisitados Nodos explorados.
+ * @param limiteNodos Si es mayor que 0, se devuelve la mejor solucion
+ * encontrada tras explorar ese numero de nodos (puede no ser la optima).
+ * Con 0, el valor por defecto, no hay limite: se explora hasta demostrar
+ * la optima, con el coste del peor caso.
+ */
+void mochilaMultiDimRamPoda(std::vector<ObjetoMultiDim> const &objetos,
+                            std::vector<double> const &M,
+                            std::vector<bool> &solMejor, double &valorMejor,
+                            long long int &nodosVisitados,
+                            long long int limiteNodos = 0);
+
+/**
+ * Resuelve el problema de la mochila 0-1 multidimensional mediante un
+ * algoritmo genetico. Los cromosomas que no caben se reparan quitando los
+ * objetos de menor densidad subrogada y se completan con los de mayor
+ * densidad que quepan.
+ *
+ * Coste tiempo: O(dnm * maxGeneraciones), n = numero de objetos, m =
+ *                  tamanyo de la poblacion, d = numero de dimensiones.
+ * Coste espacio: O(dn + nm)
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila en cada dimension.
+ * @param solMejor Indica si se coge el objeto o no.
+ * @param valorMejor Valor de la mochila con los objetos dados por solMejor.
+ * @param config Parametros del algoritmo.
+ */
+void mochilaMultiDimGenetico(std::vector<ObjetoMultiDim> const &objetos,
+                             std::vector<double> const &M,
+                             std::vector<bool> &solMejor, double &valorMejor,
+                             ConfigGenetico const &config = ConfigGenetico());
 
 #endif //PROBLEMAMOCHILACPP_ALGORITMOS_H
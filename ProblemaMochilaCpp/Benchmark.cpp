@@ -0,0 +1,647 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+#include "Algoritmos.h"
+#include "Cache.h"
+#include "CasosPrueba.h"
+#include "Estadisticas.h"
+#include "Perfil.h"
+#include "Solucion.h"
+
+/*
+ * Banco de pruebas de los algoritmos. Sustituye a los casoPrueba* cuando
+ * se quieren medidas fiables: ejecuta varias vueltas de calentamiento sin
+ * medir, separa el tiempo de carga del fichero del tiempo de resolucion,
+ * resume las muestras (mediana, percentiles, varianza) y puede volcar los
+ * resultados en CSV y JSON para comparar distintas compilaciones.
+ *
+ * Uso: Benchmark -a <algoritmos> [-r repeticiones] [-w calentamiento]
+ *                [-e epsilon] [-g configGenetico] [-c cota] [-k bloque]
+ *                [--local] [--cache fichero] [--limite bytes] [--perfil]
+ *                [--hw] [--csv fichero] [--json fichero]
+ *                [--soluciones fichero] ficheros...
+ *
+ * La cota de rampoda puede ser dantzig (por defecto), mt o critico. Con
+ * --local rampoda parte de la solucion de la busqueda local.
+ *
+ * El algoritmo cache es rampoda detras de una cache de soluciones: salvo
+ * la primera vuelta de calentamiento, mide lo que tarda un acierto. Con
+ * --cache las soluciones se guardan tambien en el fichero dado.
+ *
+ * progdin aplica hasta bloque objetos (8 por defecto, ver -k) en cada pasada
+ * por la fila; progdinfila aplica siempre uno. Para los dos se muestran
+ * ademas las celdas por segundo y los GB/s equivalentes de fila, contando
+ * 16 bytes por celda (la fila se lee y se escribe una vez por objeto): no
+ * es el trafico real, con bloques la memoria mueve menos que eso y el
+ * numero indica cuanto se ahorra. Con --hw se muestra tambien el trafico
+ * medido en la tabla, los fallos de cache por 64 bytes entre su tiempo.
+ * Si las instancias son de suma de subconjuntos, progdin usa una tabla de
+ * bits que no se compara con la fila y no se muestra nada de esto.
+ *
+ * De progdin, progdinfila, rampoda y cache se cuenta la memoria dinamica de
+ * cada resolucion (ver Memoria.h) y se muestra el pico, el numero de
+ * reservas y los bytes reservados, tambien en el CSV y el JSON. Con
+ * --limite se les pone ese limite en bytes; entonces se indica tambien si
+ * lo han superado y cuantas veces han seguido con menos memoria (progdin
+ * con las decisiones en fichero o menos objetos por pasada, rampoda
+ * parando antes).
+ *
+ * Con --perfil se hace una vuelta mas, fuera de las medidas, con el perfil
+ * por fases de cada algoritmo (y los contadores hardware con --hw).
+ *
+ * Con --soluciones se hace otra vuelta sin medir que guarda la solucion de
+ * cada algoritmo en el fichero dado (ver EscritorSoluciones), en el orden
+ * en que se miden: por algoritmo y, dentro de cada uno, por fichero.
+ */
+
+struct Instancia {
+    double M;
+    std::vector<ObjetoReal> objetos;
+    int MInt;
+    std::vector<ObjetoInt> objetosInt;
+    bool valida = true;     //False si no se ha podido leer o el algoritmo
+                            // es entero y no cabe en int
+};
+
+struct Opciones {
+    std::vector<std::string> algoritmos;
+    std::vector<std::string> ficheros;
+    int repeticiones = 10;
+    int calentamiento = 2;
+    double epsilon = 0.1;
+    ConfigGenetico genetico;
+    OpcionesRamPoda ramPoda;
+    OpcionesProgDin progDin;
+    std::string ficheroCache;
+    std::shared_ptr<CacheSoluciones> cache;
+    uint64_t idCache = 0;   //Resolutor de cache (ver idResolutor)
+    size_t limiteMemoria = 0;
+    std::shared_ptr<ContadorMemoria> memoria;
+    bool perfil = false, hw = false;
+    std::string csv, json;
+    std::string ficheroSoluciones;
+    std::shared_ptr<EscritorSoluciones> soluciones;
+    SolucionDispersa *solucion = nullptr;   //Si no es nullptr, el algoritmo
+                                            // deja aqui su solucion
+};
+
+struct Algoritmo {
+    std::string nombre;
+    bool entero;    //Si trabaja con ObjetoInt
+    std::function<double(Instancia const &, Opciones const &,
+                         Perfil *)> resuelve;
+    bool tabla = false;     //Si recorre la tabla n x (M+1) de progdin
+};
+
+struct Resultado {
+    std::string algoritmo, fichero;
+    size_t n;
+    double valor;
+    std::vector<double> tiemposCarga, tiemposResol;
+    ResumenTiempos carga, resol;
+    double celdas = 0;      //Celdas de la tabla por resolucion, si tabla
+    double gbMedidos = 0;   //GB/s de memoria en la tabla, si tabla y --hw
+    size_t picoMemoria = 0;     //Maximo de las resoluciones medidas
+    long long reservas = 0;     //De la ultima resolucion medida
+    size_t bytesReservados = 0; //De la ultima resolucion medida
+    long long degradaciones = 0;
+    bool limiteSuperado = false;
+    std::string perfil;     //Perfil por fases ya formateado
+};
+
+/**
+ * Si op.solucion no es nullptr, deja en ella la solucion 0-1 en forma
+ * dispersa. Coste: O(n).
+ */
+void guardaSolucion(Opciones const &op, std::vector<bool> const &sol) {
+    if (op.solucion)
+        solucionDispersa(sol, *op.solucion);
+}
+
+/**
+ * Igual con una solucion fraccionaria. Coste: O(n).
+ */
+void guardaSolucion(Opciones const &op, std::vector<double> const &sol) {
+    if (op.solucion)
+        solucionDispersa(sol, *op.solucion);
+}
+
+/**
+ * Devuelve la tabla con los algoritmos que se pueden medir.
+ */
+std::vector<Algoritmo> algoritmosDisponibles() {
+    return {
+            {"voraz",        false, [](Instancia const &ins, Opciones const &op,
+                                       Perfil *perfil) {
+                std::vector<double> sol(ins.objetos.size());
+                double valor;
+                mochilaVoraz(ins.objetos, ins.M, sol, valor, perfil);
+                guardaSolucion(op, sol);
+                return valor;
+            }},
+            {"vorazdispersa", false, [](Instancia const &ins,
+                                        Opciones const &op, Perfil *perfil) {
+                SolucionDispersa sol;
+                double valor;
+                mochilaVoraz(ins.objetos, ins.M, sol, valor, perfil);
+                if (op.solucion)
+                    *op.solucion = sol;
+                return valor;
+            }},
+            {"progdin",      true,  [](Instancia const &ins,
+                                       Opciones const &op, Perfil *perfil) {
+                std::vector<bool> sol(ins.objetosInt.size());
+                double valor;
+                mochilaProgDin(ins.objetosInt, ins.MInt, sol, valor, perfil,
+                               op.progDin);
+                guardaSolucion(op, sol);
+                return valor;
+            }, true},
+            {"progdinfila",  true,  [](Instancia const &ins,
+                                       Opciones const &op, Perfil *perfil) {
+                std::vector<bool> sol(ins.objetosInt.size());
+                double valor;
+                OpcionesProgDin opciones = op.progDin;
+                opciones.objetosPorBloque = 1;
+                mochilaProgDin(ins.objetosInt, ins.MInt, sol, valor, perfil,
+                               opciones);
+                guardaSolucion(op, sol);
+                return valor;
+            }, true},
+            {"dispersa",     false, [](Instancia const &ins, Opciones const &op,
+                                       Perfil *) {
+                std::vector<bool> sol(ins.objetos.size());
+                double valor;
+                mochilaProgDinDispersa(ins.objetos, ins.M, sol, valor);
+                guardaSolucion(op, sol);
+                return valor;
+            }},
+            {"mitades",      false, [](Instancia const &ins, Opciones const &op,
+                                       Perfil *) {
+                std::vector<bool> sol(ins.objetos.size());
+                double valor;
+                mochilaMitades(ins.objetos, ins.M, sol, valor);
+                guardaSolucion(op, sol);
+                return valor;
+            }},
+            {"progdinvalor", false, [](Instancia const &ins, Opciones const &op,
+                                       Perfil *) {
+                std::vector<bool> sol(ins.objetos.size());
+                double valor;
+                mochilaProgDinValor(ins.objetos, ins.M, sol, valor);
+                guardaSolucion(op, sol);
+                return valor;
+            }},
+            {"fptas",        false, [](Instancia const &ins,
+                                       Opciones const &op, Perfil *) {
+                std::vector<bool> sol(ins.objetos.size());
+                double valor;
+                mochilaFPTAS(ins.objetos, ins.M, op.epsilon, sol, valor);
+                guardaSolucion(op, sol);
+                return valor;
+            }},
+            {"rampoda",      false, [](Instancia const &ins,
+                                       Opciones const &op, Perfil *perfil) {
+                std::vector<bool> sol(ins.objetos.size());
+                double valor;
+                long long int nodos;
+                mochilaRamPoda(ins.objetos, ins.M, sol, valor, nodos,
+                               perfil, op.ramPoda);
+                guardaSolucion(op, sol);
+                return valor;
+            }},
+            {"genetico",     false, [](Instancia const &ins,
+                                       Opciones const &op, Perfil *perfil) {
+                std::vector<bool> sol(ins.objetos.size());
+                double valor;
+                mochilaGenetico(ins.objetos, ins.M, sol, valor, perfil,
+                                op.genetico);
+                guardaSolucion(op, sol);
+                return valor;
+            }},
+            {"cache",        false, [](Instancia const &ins,
+                                       Opciones const &op, Perfil *perfil) {
+                std::vector<bool> sol(ins.objetos.size());
+                double valor;
+                mochilaConCache(*op.cache, ins.objetos, ins.M, sol, valor,
+                                [&](std::vector<ObjetoReal> const &objetos,
+                                    double M, std::vector<bool> &solucion,
+                                    double &valorSol) {
+                    long long int nodos;
+                    mochilaRamPoda(objetos, M, solucion, valorSol, nodos,
+                                   perfil, op.ramPoda);
+                }, op.idCache);
+                guardaSolucion(op, sol);
+                return valor;
+            }},
+            {"local",        false, [](Instancia const &ins, Opciones const &op,
+                                       Perfil *perfil) {
+                std::vector<bool> sol(ins.objetos.size());
+                double valor;
+                mochilaBusquedaLocal(ins.objetos, ins.M, sol, valor, perfil);
+                guardaSolucion(op, sol);
+                return valor;
+            }},
+    };
+}
+
+/**
+ * Separa una lista de nombres separados por comas.
+ */
+std::vector<std::string> separaComas(std::string const &lista) {
+    std::vector<std::string> nombres;
+    std::stringstream ss(lista);
+    std::string nombre;
+    while (std::getline(ss, nombre, ','))
+        if (!nombre.empty())
+            nombres.push_back(nombre);
+    return nombres;
+}
+
+void muestraUso() {
+    std::cout << "Uso: Benchmark -a <algoritmos> [-r repeticiones] "
+                 "[-w calentamiento] [-e epsilon] [-g configGenetico] "
+                 "[-c dantzig|mt|critico] [-k bloque] [--local] "
+                 "[--cache fichero] [--limite bytes] "
+                 "[--perfil] [--hw] [--csv fichero] [--json fichero] "
+                 "[--soluciones fichero] ficheros...\n"
+                 "Algoritmos (separados por comas):";
+    for (Algoritmo const &a : algoritmosDisponibles())
+        std::cout << ' ' << a.nombre;
+    std::cout << '\n';
+}
+
+/**
+ * Lee las opciones de la linea de comandos.
+ *
+ * @return False si las opciones no son validas.
+ */
+bool leeOpciones(int argc, char *argv[], Opciones &op) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool conValor = arg == "-a" || arg == "-r" || arg == "-w" ||
+                        arg == "-e" || arg == "-g" || arg == "-c" ||
+                        arg == "-k" ||
+                        arg == "--csv" || arg == "--json" ||
+                        arg == "--cache" || arg == "--limite" ||
+                        arg == "--soluciones";
+        if (conValor && i + 1 >= argc)
+            return false;
+        if (arg == "-a")
+            op.algoritmos = separaComas(argv[++i]);
+        else if (arg == "-r")
+            op.repeticiones = std::atoi(argv[++i]);
+        else if (arg == "-w")
+            op.calentamiento = std::atoi(argv[++i]);
+        else if (arg == "-e")
+            op.epsilon = std::atof(argv[++i]);
+        else if (arg == "-g") {
+            if (!leeConfigGenetico(argv[++i], op.genetico))
+                return false;
+        } else if (arg == "-c") {
+            std::string cota = argv[++i];
+            if (cota == "dantzig")
+                op.ramPoda.cota = COTA_DANTZIG;
+            else if (cota == "mt")
+                op.ramPoda.cota = COTA_MARTELLO_TOTH;
+            else if (cota == "critico")
+                op.ramPoda.cota = COTA_CRITICO;
+            else
+                return false;
+        }
+        else if (arg == "-k")
+            op.progDin.objetosPorBloque = std::atoi(argv[++i]);
+        else if (arg == "--csv")
+            op.csv = argv[++i];
+        else if (arg == "--json")
+            op.json = argv[++i];
+        else if (arg == "--cache")
+            op.ficheroCache = argv[++i];
+        else if (arg == "--soluciones")
+            op.ficheroSoluciones = argv[++i];
+        else if (arg == "--limite")
+            op.limiteMemoria = (size_t) std::atoll(argv[++i]);
+        else if (arg == "--local")
+            op.ramPoda.busquedaLocal = true;
+        else if (arg == "--perfil")
+            op.perfil = true;
+        else if (arg == "--hw")
+            op.perfil = op.hw = true;
+        else if (!arg.empty() && arg[0] == '-')
+            return false;
+        else
+            op.ficheros.push_back(arg);
+    }
+    return !op.algoritmos.empty() && !op.ficheros.empty() &&
+           op.repeticiones > 0 && op.calentamiento >= 0 &&
+           op.progDin.objetosPorBloque > 0;
+}
+
+/**
+ * Carga la instancia del fichero en el formato que necesita el algoritmo.
+ * Los ficheros terminados en .bin se leen en el formato binario. Si el
+ * fichero binario no se puede leer, o el algoritmo es entero y M o algun
+ * peso no cabe en int, se muestra un error y se marca la instancia como no
+ * valida.
+ *
+ * @return Segundos que ha tardado la carga.
+ */
+double cargaInstancia(Algoritmo const &alg, std::string const &fichero,
+                      Instancia &ins) {
+    auto t1 = std::chrono::steady_clock::now();
+    ins.valida = true;
+    bool binario = fichero.size() > 4 &&
+                   fichero.compare(fichero.size() - 4, 4, ".bin") == 0;
+    if (binario) {
+        ins.valida = leeCasoPruebaMochilaBin(fichero, ins.M, ins.objetos);
+        if (ins.valida && alg.entero)
+            ins.valida = pasaAEntero(ins.M, ins.objetos, ins.MInt,
+                                     ins.objetosInt);
+    } else if (alg.entero) {
+        ins.valida = leeCasoPruebaMochilaInt(fichero, ins.MInt,
+                                             ins.objetosInt);
+    } else {
+        ins.objetos.clear();
+        leeCasoPruebaMochilaReal(fichero, ins.M, ins.objetos);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t2 - t1).count();
+}
+
+/**
+ * Mide un algoritmo sobre un fichero: calentamiento vueltas sin medir y
+ * despues repeticiones vueltas midiendo carga y resolucion por separado.
+ * Con op.soluciones se resuelve una vez mas, sin medir, y se escribe la
+ * solucion.
+ *
+ * @return False si la instancia no es valida para el algoritmo.
+ */
+bool mide(Algoritmo const &alg, std::string const &fichero,
+          Opciones const &op, Resultado &res) {
+    Instancia ins;
+    res.algoritmo = alg.nombre;
+    res.fichero = fichero;
+
+    //La primera carga, sin medir, dice si la instancia es valida
+    cargaInstancia(alg, fichero, ins);
+    if (!ins.valida)
+        return false;
+
+    for (int i = 0; i < op.calentamiento; ++i) {
+        if (i > 0)
+            cargaInstancia(alg, fichero, ins);
+        alg.resuelve(ins, op, nullptr);
+    }
+
+    for (int i = 0; i < op.repeticiones; ++i) {
+        res.tiemposCarga.push_back(cargaInstancia(alg, fichero, ins));
+
+        op.memoria->reinicia();
+        auto t1 = std::chrono::steady_clock::now();
+        res.valor = alg.resuelve(ins, op, nullptr);
+        auto t2 = std::chrono::steady_clock::now();
+        res.tiemposResol.push_back(
+                std::chrono::duration<double>(t2 - t1).count());
+
+        res.picoMemoria = std::max(res.picoMemoria, op.memoria->pico);
+        res.reservas = op.memoria->reservas;
+        res.bytesReservados = op.memoria->bytesTotales;
+        res.degradaciones += op.memoria->degradaciones;
+        res.limiteSuperado |= op.memoria->limiteSuperado;
+    }
+    res.n = alg.entero ? ins.objetosInt.size() : ins.objetos.size();
+    //Con limite superado puede no haberse rellenado, y la suma de
+    // subconjuntos recorre bits en vez de celdas de la fila
+    if (alg.tabla && !res.limiteSuperado &&
+        !proporcionConstante(ins.objetosInt))
+        res.celdas = (double) res.n * ((double) ins.MInt + 1);
+
+    resumeTiempos(res.tiemposCarga, res.carga);
+    resumeTiempos(res.tiemposResol, res.resol);
+
+    if (op.perfil) {
+        Perfil perfil(op.hw);
+        alg.resuelve(ins, op, &perfil);
+        std::ostringstream out;
+        perfil.muestra(out);
+        res.perfil = out.str();
+
+        //Cada fallo de cache trae una linea de 64 bytes de memoria
+        MedidaFase const &tabla = perfil.fases[FASE_TABLA];
+        if (res.celdas > 0 && perfil.hayContadoresHw() &&
+            tabla.segundos > 0)
+            res.gbMedidos = (double) tabla.hw.fallosCache * 64 /
+                            tabla.segundos / 1e9;
+    }
+
+    if (op.soluciones) {
+        SolucionDispersa sol;
+        Opciones conSolucion = op;
+        conSolucion.solucion = &sol;
+        double valor = alg.resuelve(ins, conSolucion, nullptr);
+        op.soluciones->escribe(sol, valor);
+    }
+    return true;
+}
+
+void escribeResumenCSV(std::ostream &out, ResumenTiempos const &r) {
+    out << ',' << r.minimo << ',' << r.mediana << ',' << r.p90 << ','
+        << r.p99 << ',' << r.maximo << ',' << r.media << ',' << r.varianza;
+}
+
+void escribeCSV(std::string const &fichero,
+                std::vector<Resultado> const &resultados) {
+    std::ofstream out(fichero);
+    out.precision(9);
+    out << "algoritmo,fichero,n,valor,repeticiones";
+    for (std::string pre : {"carga", "resol"})
+        for (std::string campo : {"min", "mediana", "p90", "p99", "max",
+                                  "media", "varianza"})
+            out << ',' << pre << '_' << campo;
+    out << ",pico_memoria,reservas,bytes_reservados,degradaciones,"
+           "limite_superado\n";
+    for (Resultado const &r : resultados) {
+        out << r.algoritmo << ',' << r.fichero << ',' << r.n << ','
+            << r.valor << ',' << r.resol.muestras;
+        escribeResumenCSV(out, r.carga);
+        escribeResumenCSV(out, r.resol);
+        out << ',' << r.picoMemoria << ',' << r.reservas << ','
+            << r.bytesReservados << ',' << r.degradaciones << ','
+            << (r.limiteSuperado ? 1 : 0) << '\n';
+    }
+}
+
+void escribeResumenJSON(std::ostream &out, ResumenTiempos const &r) {
+    out << "{\"min\": " << r.minimo << ", \"mediana\": " << r.mediana
+        << ", \"p90\": " << r.p90 << ", \"p99\": " << r.p99
+        << ", \"max\": " << r.maximo << ", \"media\": " << r.media
+        << ", \"varianza\": " << r.varianza << "}";
+}
+
+void escribeMuestrasJSON(std::ostream &out, std::vector<double> const &v) {
+    out << '[';
+    for (size_t i = 0; i < v.size(); ++i)
+        out << (i ? ", " : "") << v[i];
+    out << ']';
+}
+
+/**
+ * Escribe s como cadena JSON, escapando comillas, barras y saltos de linea.
+ */
+void escribeCadenaJSON(std::ostream &out, std::string const &s) {
+    out << '"';
+    for (char c : s) {
+        if (c == '"' || c == '\\')
+            out << '\\' << c;
+        else if (c == '\n')
+            out << "\\n";
+        else
+            out << c;
+    }
+    out << '"';
+}
+
+void escribeJSON(std::string const &fichero,
+                 std::vector<Resultado> const &resultados) {
+    std::ofstream out(fichero);
+    out.precision(9);
+    out << "{\n  \"compilador\": \"" << __VERSION__ << "\",\n"
+        << "  \"compilado\": \"" << __DATE__ << ' ' << __TIME__ << "\",\n"
+        << "  \"resultados\": [\n";
+    for (size_t i = 0; i < resultados.size(); ++i) {
+        Resultado const &r = resultados[i];
+        out << "    {\"algoritmo\": \"" << r.algoritmo << "\", \"fichero\": \""
+            << r.fichero << "\", \"n\": " << r.n << ", \"valor\": "
+            << r.valor << ",\n     \"carga\": ";
+        escribeResumenJSON(out, r.carga);
+        out << ",\n     \"resol\": ";
+        escribeResumenJSON(out, r.resol);
+        out << ",\n     \"muestrasCarga\": ";
+        escribeMuestrasJSON(out, r.tiemposCarga);
+        out << ",\n     \"muestrasResol\": ";
+        escribeMuestrasJSON(out, r.tiemposResol);
+        if (r.reservas > 0 || r.limiteSuperado)
+            out << ",\n     \"memoria\": {\"pico\": " << r.picoMemoria
+                << ", \"reservas\": " << r.reservas
+                << ", \"bytesReservados\": " << r.bytesReservados
+                << ", \"degradaciones\": " << r.degradaciones
+                << ", \"limiteSuperado\": "
+                << (r.limiteSuperado ? "true" : "false") << '}';
+        if (!r.perfil.empty()) {
+            out << ",\n     \"perfil\": ";
+            escribeCadenaJSON(out, r.perfil);
+        }
+        out << '}' << (i + 1 < resultados.size() ? "," : "") << '\n';
+    }
+    out << "  ]\n}\n";
+}
+
+int main(int argc, char *argv[]) {
+    Opciones op;
+    if (!leeOpciones(argc, argv, op)) {
+        muestraUso();
+        return 1;
+    }
+    op.cache = std::make_shared<CacheSoluciones>(1024, op.ficheroCache);
+    //Con limite de memoria rampoda puede parar antes de la optima, asi que
+    // sus soluciones no se mezclan con las de sin limite ni con otro limite
+    std::string resolutorCache = "rampoda";
+    if (op.limiteMemoria > 0)
+        resolutorCache += " --limite " + std::to_string(op.limiteMemoria);
+    op.idCache = idResolutor(resolutorCache);
+    op.memoria = std::make_shared<ContadorMemoria>(op.limiteMemoria);
+    op.ramPoda.memoria = op.memoria.get();
+    op.progDin.memoria = op.memoria.get();
+
+    if (!op.ficheroSoluciones.empty()) {
+        op.soluciones = std::make_shared<EscritorSoluciones>();
+        if (!op.soluciones->abre(op.ficheroSoluciones))
+            return 1;
+    }
+
+    //Comprobamos los algoritmos y los ficheros antes de empezar a medir
+    std::vector<Algoritmo> disponibles = algoritmosDisponibles();
+    std::vector<Algoritmo> elegidos;
+    for (std::string const &nombre : op.algoritmos) {
+        bool encontrado = false;
+        for (Algoritmo const &a : disponibles) {
+            if (a.nombre == nombre) {
+                elegidos.push_back(a);
+                encontrado = true;
+            }
+        }
+        if (!encontrado) {
+            std::cout << "ERROR. Algoritmo desconocido: " << nombre << '\n';
+            muestraUso();
+            return 1;
+        }
+    }
+    for (std::string const &fichero : op.ficheros) {
+        if (!std::ifstream(fichero).is_open()) {
+            std::cout << "ERROR. No se ha podido abrir " << fichero << '\n';
+            return 1;
+        }
+    }
+
+    srand((unsigned int) time(NULL));
+
+    std::vector<Resultado> resultados;
+    for (Algoritmo const &alg : elegidos) {
+        for (std::string const &fichero : op.ficheros) {
+            Resultado res;
+            if (!mide(alg, fichero, op, res)) {
+                std::cout << alg.nombre << ' ' << fichero
+                          << " no se mide\n";
+                continue;
+            }
+            resultados.push_back(res);
+
+            std::cout << alg.nombre << ' ' << fichero << " n=" << res.n
+                      << " valor=" << res.valor << '\n'
+                      << "  carga: mediana " << res.carga.mediana
+                      << " s\n"
+                      << "  resol: mediana " << res.resol.mediana
+                      << " s, p90 " << res.resol.p90 << " s, p99 "
+                      << res.resol.p99 << " s, min " << res.resol.minimo
+                      << " s, max " << res.resol.maximo << " s, desv "
+                      << res.resol.desviacion << " s\n";
+            if (res.celdas > 0 && res.resol.mediana > 0) {
+                double celdasSeg = res.celdas / res.resol.mediana;
+                std::cout << "  tabla: " << celdasSeg << " celdas/s, "
+                          << celdasSeg * 16 / 1e9
+                          << " GB/s equivalentes de fila";
+                if (res.gbMedidos > 0)
+                    std::cout << ", " << res.gbMedidos << " GB/s medidos";
+                std::cout << '\n';
+            }
+            if (res.reservas > 0 || res.limiteSuperado) {
+                std::cout << "  memoria: pico " << res.picoMemoria
+                          << " bytes, " << res.reservas << " reservas de "
+                          << res.bytesReservados << " bytes";
+                if (res.limiteSuperado)
+                    std::cout << ", limite superado";
+                if (res.degradaciones > 0)
+                    std::cout << ", " << res.degradaciones
+                              << " degradaciones";
+                std::cout << '\n';
+            }
+            std::cout << res.perfil;
+        }
+    }
+
+    if (!op.csv.empty())
+        escribeCSV(op.csv, resultados);
+    if (!op.json.empty())
+        escribeJSON(op.json, resultados);
+    if (op.soluciones && !op.soluciones->cierra())
+        return 1;
+    return 0;
+}
@@ -0,0 +1,443 @@
+#include "Cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CACHE_MMAP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#endif
+
+static const char MAGICO[8] = {'M', 'O', 'C', 'H', 'C', 'A', 'C', '2'};
+
+/**
+ * Mezcla los bits de x (finalizador de splitmix64).
+ */
+static inline uint64_t mezcla(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/**
+ * Bits del double, con -0 y 0 iguales.
+ */
+static inline uint64_t bitsReal(double x) {
+    uint64_t b;
+    if (x == 0)
+        x = 0;
+    std::memcpy(&b, &x, sizeof b);
+    return b;
+}
+
+/**
+ * Anyade la palabra w a las dos mitades de la clave.
+ */
+static inline void anyadeClave(ClaveInstancia &c, uint64_t w) {
+    c.h1 = mezcla(c.h1 ^ w);
+    c.h2 = ((c.h2 << 29) | (c.h2 >> 35)) + mezcla(w + 0x9e3779b97f4a7c15ULL);
+}
+
+static const ClaveInstancia CLAVE_INICIAL = {0x6a09e667f3bcc908ULL,
+                                             0xbb67ae8584caa73bULL, 0};
+
+/**
+ * Identificador del resolutor de nombre dado para la clave. Es el mismo en
+ * todas las ejecuciones, asi que sirve para el fichero. Resolutores que
+ * pueden dar soluciones distintas deben tener nombres distintos.
+ *
+ * Coste: O(longitud del nombre).
+ *
+ * @param nombre Nombre del resolutor.
+ * @return Identificador del resolutor.
+ */
+uint64_t idResolutor(std::string const &nombre) {
+    uint64_t id = CLAVE_INICIAL.h1;
+    for (char c : nombre)
+        id = mezcla(id ^ (unsigned char) c);
+    return id;
+}
+
+/**
+ * Calcula la clave de (M, pesos, valores) con los objetos en el orden dado.
+ * Para una instancia en forma canonica es la clave canonica.
+ *
+ * Coste: O(n), n = numero de objetos.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param resolutor Identificador del resolutor (ver idResolutor).
+ * @return Clave de la instancia.
+ */
+ClaveInstancia claveInstancia(std::vector<ObjetoReal> const &objetos,
+                              double M, uint64_t resolutor) {
+    ClaveInstancia clave = CLAVE_INICIAL;
+    clave.resolutor = resolutor;
+    anyadeClave(clave, bitsReal(M));
+    anyadeClave(clave, objetos.size());
+    for (ObjetoReal const &o : objetos) {
+        anyadeClave(clave, bitsReal(o.peso));
+        anyadeClave(clave, bitsReal(o.valor));
+    }
+    return clave;
+}
+
+/**
+ * Calcula el orden canonico de los objetos: por peso y, a igual peso, por
+ * valor. orig[j] es el objeto original de la posicion j.
+ *
+ * Coste: O(n logn), n = numero de objetos.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param orig Objeto original de cada posicion.
+ */
+void ordenCanonico(std::vector<ObjetoReal> const &objetos,
+                   std::vector<size_t> &orig) {
+    const size_t n = objetos.size();
+    orig.resize(n);
+    for (size_t i = 0; i < n; ++i)
+        orig[i] = i;
+    std::sort(orig.begin(), orig.end(), [&](size_t a, size_t b) {
+        if (objetos[a].peso != objetos[b].peso)
+            return objetos[a].peso < objetos[b].peso;
+        return objetos[a].valor < objetos[b].valor;
+    });
+}
+
+/**
+ * Pasa la instancia a su forma canonica: ordena los objetos por peso y, a
+ * igual peso, por valor, y calcula la clave de (M, pesos, valores).
+ *
+ * Coste: O(n logn), n = numero de objetos.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param resolutor Identificador del resolutor (ver idResolutor).
+ * @param can Instancia canonica.
+ */
+void canonicaliza(std::vector<ObjetoReal> const &objetos, double M,
+                  uint64_t resolutor, InstanciaCanonica &can) {
+    const size_t n = objetos.size();
+    can.M = M;
+    ordenCanonico(objetos, can.orig);
+    can.objetos.resize(n);
+    for (size_t j = 0; j < n; ++j)
+        can.objetos[j] = objetos[can.orig[j]];
+    can.clave = claveInstancia(can.objetos, M, resolutor);
+}
+
+/*
+ * Formato del fichero: MAGICO y despues los registros, todos con campos de
+ * 8 bytes: h1, h2, resolutor, n, valor y ceil(n / 64) palabras con la
+ * solucion.
+ */
+
+static const size_t CABECERA_REGISTRO = 5 * sizeof(uint64_t);
+
+static inline size_t bytesRegistro(size_t n) {
+    return CABECERA_REGISTRO + (n + 63) / 64 * sizeof(uint64_t);
+}
+
+AlmacenSoluciones::~AlmacenSoluciones() {
+    cierra();
+}
+
+void AlmacenSoluciones::cierra() {
+#ifdef CACHE_MMAP
+    if (datos)
+        munmap((void *) datos, bytesProyectados);
+    if (fd >= 0)
+        close(fd);
+#endif
+    datos = nullptr;
+    bytesProyectados = bytesFichero = 0;
+    fd = -1;
+    indice.clear();
+}
+
+/**
+ * Proyecta en memoria los primeros bytes del fichero, quitando la
+ * proyeccion anterior.
+ */
+bool AlmacenSoluciones::proyecta(size_t bytes) {
+#ifdef CACHE_MMAP
+    if (datos)
+        munmap((void *) datos, bytesProyectados);
+    void *p = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        datos = nullptr;
+        bytesProyectados = 0;
+        return false;
+    }
+    datos = (const unsigned char *) p;
+    bytesProyectados = bytes;
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Abre (o crea) el fichero. Si no se puede, muestra un error y devuelve
+ * false; el almacen queda cerrado.
+ */
+bool AlmacenSoluciones::abre(std::string const &fichero) {
+    cierra();
+#ifdef CACHE_MMAP
+    fd = open(fichero.c_str(), O_RDWR | O_CREAT, 0644);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        std::cout << "ERROR. No se ha podido abrir el fichero.\n";
+        cierra();
+        return false;
+    }
+    bytesFichero = (size_t) st.st_size;
+    if (bytesFichero == 0) {
+        if (pwrite(fd, MAGICO, sizeof MAGICO, 0) != sizeof MAGICO) {
+            std::cout << "ERROR. No se ha podido escribir el fichero.\n";
+            cierra();
+            return false;
+        }
+        bytesFichero = sizeof MAGICO;
+    }
+    if (!proyecta(bytesFichero) ||
+        std::memcmp(datos, MAGICO, sizeof MAGICO) != 0) {
+        std::cout << "ERROR. El fichero no es una cache de soluciones.\n";
+        cierra();
+        return false;
+    }
+
+    //Indexamos los registros. Si el ultimo esta a medias (la escritura se
+    // corto), se sobrescribe con el siguiente
+    size_t pos = sizeof MAGICO;
+    while (pos + CABECERA_REGISTRO <= bytesFichero) {
+        uint64_t cab[4];
+        std::memcpy(cab, datos + pos, sizeof cab);
+        size_t tam = bytesRegistro((size_t) cab[3]);
+        if (pos + tam > bytesFichero)
+            break;
+        indice[{cab[0], cab[1], cab[2]}] = pos;
+        pos += tam;
+    }
+    bytesFichero = pos;
+    return true;
+#else
+    std::cout << "ERROR. La cache en fichero necesita mmap.\n";
+    return false;
+#endif
+}
+
+/**
+ * Busca la solucion de la instancia con clave dada y n objetos.
+ * Coste: O(n) si esta, O(1) si no.
+ */
+bool AlmacenSoluciones::busca(ClaveInstancia const &clave, size_t n,
+                              std::vector<bool> &solucion, double &valorSol) {
+    auto it = indice.find(clave);
+    if (it == indice.end())
+        return false;
+    const size_t pos = it->second;
+    if (pos + bytesRegistro(n) > bytesProyectados && !proyecta(bytesFichero))
+        return false;
+
+    uint64_t cab[5];
+    std::memcpy(cab, datos + pos, sizeof cab);
+    if (cab[3] != n)
+        return false;
+    std::memcpy(&valorSol, &cab[4], sizeof valorSol);
+    solucion.resize(n);
+    const unsigned char *palabras = datos + pos + CABECERA_REGISTRO;
+    for (size_t w = 0; w * 64 < n; ++w) {
+        uint64_t bits;
+        std::memcpy(&bits, palabras + w * sizeof bits, sizeof bits);
+        for (size_t i = w * 64; i < n && i < w * 64 + 64; ++i)
+            solucion[i] = (bits >> (i - w * 64)) & 1;
+    }
+    return true;
+}
+
+/**
+ * Anyade la solucion al final del fichero. Coste: O(n).
+ */
+void AlmacenSoluciones::anyade(ClaveInstancia const &clave,
+                               std::vector<bool> const &solucion,
+                               double valorSol) {
+#ifdef CACHE_MMAP
+    if (fd < 0 || indice.count(clave))
+        return;
+    const size_t n = solucion.size();
+    std::vector<uint64_t> reg(bytesRegistro(n) / sizeof(uint64_t), 0);
+    reg[0] = clave.h1;
+    reg[1] = clave.h2;
+    reg[2] = clave.resolutor;
+    reg[3] = n;
+    std::memcpy(&reg[4], &valorSol, sizeof valorSol);
+    for (size_t i = 0; i < n; ++i)
+        if (solucion[i])
+            reg[5 + i / 64] |= (uint64_t) 1 << (i % 64);
+
+    const size_t bytes = reg.size() * sizeof(uint64_t);
+    ssize_t escritos = pwrite(fd, reg.data(), bytes, (off_t) bytesFichero);
+    if (escritos != (ssize_t) bytes) {
+        std::cout << "ERROR. No se ha podido escribir el fichero.\n";
+        return;
+    }
+    indice[clave] = bytesFichero;
+    bytesFichero += bytes;
+#endif
+}
+
+/**
+ * Crea una cache con capacidad soluciones en memoria. Si fichero no es
+ * vacio, las soluciones se guardan tambien en ese fichero.
+ */
+CacheSoluciones::CacheSoluciones(size_t capacidad, std::string const &fichero)
+        : capacidad(capacidad) {
+    if (!fichero.empty())
+        almacen.abre(fichero);
+}
+
+void CacheSoluciones::guardaMemoria(ClaveInstancia const &clave,
+                                    std::vector<bool> const &solucion,
+                                    double valorSol) {
+    if (capacidad == 0)
+        return;
+    if (lru.size() == capacidad) {
+        mapa.erase(lru.back().clave);
+        lru.pop_back();
+    }
+    lru.push_front({clave, solucion, valorSol});
+    mapa[clave] = lru.begin();
+}
+
+/**
+ * Busca la solucion de la instancia con clave dada y n objetos, primero en
+ * memoria y despues en el fichero.
+ */
+bool CacheSoluciones::busca(ClaveInstancia const &clave, size_t n,
+                            std::vector<bool> &solucion, double &valorSol) {
+    std::lock_guard<std::mutex> cerrojo(mutex);
+    auto it = mapa.find(clave);
+    if (it != mapa.end() && it->second->solucion.size() == n) {
+        //La pasamos al principio de la lista
+        lru.splice(lru.begin(), lru, it->second);
+        solucion = it->second->solucion;
+        valorSol = it->second->valor;
+        aciertos++;
+        return true;
+    }
+    if (almacen.abierto() && almacen.busca(clave, n, solucion, valorSol)) {
+        guardaMemoria(clave, solucion, valorSol);
+        aciertosFichero++;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Guarda la solucion de la instancia con clave dada y la cuenta como fallo.
+ */
+void CacheSoluciones::guarda(ClaveInstancia const &clave,
+                             std::vector<bool> const &solucion,
+                             double valorSol) {
+    std::lock_guard<std::mutex> cerrojo(mutex);
+    fallos++;
+    if (mapa.count(clave))
+        return;
+    guardaMemoria(clave, solucion, valorSol);
+    if (almacen.abierto())
+        almacen.anyade(clave, solucion, valorSol);
+}
+
+/**
+ * Busca la clave canonica de la que directa es alias.
+ */
+bool CacheSoluciones::buscaAlias(ClaveInstancia const &directa,
+                                 ClaveInstancia &canonica) {
+    std::lock_guard<std::mutex> cerrojo(mutex);
+    auto it = alias.find(directa);
+    if (it == alias.end())
+        return false;
+    canonica = it->second;
+    return true;
+}
+
+/**
+ * Anota directa como alias de canonica. Solo en memoria y como mucho tantos
+ * como la capacidad; al llenarse se olvidan todos.
+ */
+void CacheSoluciones::guardaAlias(ClaveInstancia const &directa,
+                                  ClaveInstancia const &canonica) {
+    if (capacidad == 0 || directa == canonica)
+        return;
+    std::lock_guard<std::mutex> cerrojo(mutex);
+    if (alias.size() >= capacidad)
+        alias.clear();
+    alias[directa] = canonica;
+}
+
+/**
+ * Resuelve la instancia con resolutor salvo que su solucion ya este en la
+ * cache. La solucion se devuelve en el orden de objetos dado.
+ *
+ * Coste: O(n logn) si esta en la cache, n = numero de objetos.
+ *
+ * @param cache Cache de soluciones.
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param solucion Indica si se coge el objeto o no.
+ * @param valorSol Valor de la mochila con los objetos dados por solucion.
+ * @param resolutor Algoritmo que se usa si no esta en la cache.
+ * @param id Identificador de resolutor (ver idResolutor). Solo se
+ * devuelven soluciones guardadas con el mismo.
+ */
+void mochilaConCache(CacheSoluciones &cache,
+                     std::vector<ObjetoReal> const &objetos, double M,
+                     std::vector<bool> &solucion, double &valorSol,
+                     Resolutor const &resolutor, uint64_t id) {
+    const size_t n = objetos.size();
+    const ClaveInstancia directa = claveInstancia(objetos, M, id);
+    std::vector<bool> solCan(n);
+    std::vector<size_t> orig;
+
+    //Repeticion exacta: basta con el orden, sin copiar ni calcular la clave
+    ClaveInstancia canonica;
+    bool encontrada = false;
+    if (cache.buscaAlias(directa, canonica)) {
+        encontrada = cache.busca(canonica, n, solCan, valorSol);
+        if (encontrada)
+            ordenCanonico(objetos, orig);
+    } else {
+        //Puede que la instancia ya estuviera en orden canonico
+        encontrada = cache.busca(directa, n, solCan, valorSol);
+        if (encontrada) {
+            orig.resize(n);
+            for (size_t i = 0; i < n; ++i)
+                orig[i] = i;
+        }
+    }
+    if (!encontrada) {
+        InstanciaCanonica can;
+        canonicaliza(objetos, M, id, can);
+        if (!cache.busca(can.clave, n, solCan, valorSol)) {
+            resolutor(can.objetos, can.M, solCan, valorSol);
+            cache.guarda(can.clave, solCan, valorSol);
+        }
+        cache.guardaAlias(directa, can.clave);
+        orig.swap(can.orig);
+    }
+
+    //Volvemos al orden de quien llama
+    solucion.resize(n);
+    for (size_t j = 0; j < n; ++j)
+        solucion[orig[j]] = solCan[j];
+}
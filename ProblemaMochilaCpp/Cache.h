@@ -0,0 +1,242 @@
+#ifndef PROBLEMAMOCHILACPP_CACHE_H
+#define PROBLEMAMOCHILACPP_CACHE_H
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Algoritmos.h"
+
+/*
+ * Cache de soluciones de la mochila 0-1 indexada por el contenido de la
+ * instancia, resumido en una clave de 128 bits de (M, pesos, valores), y
+ * por el resolutor que la ha resuelto, para no devolver la solucion de una
+ * heuristica a quien pide la exacta ni al reves. Cada solucion se guarda
+ * una vez, con la clave de su forma canonica (objetos ordenados por peso y
+ * valor), que es la misma para cualquier permutacion de los objetos, y se
+ * devuelve en el orden de quien llama. La clave de los objetos en el orden
+ * dado, que cuesta O(n), se guarda como alias de la canonica: una
+ * repeticion exacta se encuentra sin copiar la instancia ni calcular la
+ * clave canonica, aunque hay que ordenar los objetos para devolver la
+ * solucion en su orden.
+ *
+ * En memoria se guardan las ultimas soluciones usadas (LRU). Opcionalmente
+ * se anyaden ademas a un fichero que solo crece y que se lee proyectado en
+ * memoria (mmap), de modo que sobreviven entre ejecuciones.
+ *
+ * Una cache se puede usar desde varios hilos a la vez: cada operacion
+ * toma su cerrojo. mochilaConCache no lo tiene mientras resuelve, asi que
+ * dos hilos con la misma instancia nueva pueden resolverla los dos; se
+ * guarda una vez.
+ */
+
+struct ClaveInstancia {
+    uint64_t h1, h2;
+    uint64_t resolutor;     //Ver idResolutor
+
+    bool operator==(ClaveInstancia const &otra) const {
+        return h1 == otra.h1 && h2 == otra.h2 && resolutor == otra.resolutor;
+    }
+};
+
+struct HashClave {
+    size_t operator()(ClaveInstancia const &c) const {
+        return (size_t) (c.h1 ^ c.resolutor);
+    }
+};
+
+struct InstanciaCanonica {
+    double M;
+    std::vector<ObjetoReal> objetos;    //Ordenados por peso y valor
+    std::vector<size_t> orig;           //Objeto original de cada posicion
+    ClaveInstancia clave;
+};
+
+/**
+ * Identificador del resolutor de nombre dado para la clave. Es el mismo en
+ * todas las ejecuciones, asi que sirve para el fichero. Resolutores que
+ * pueden dar soluciones distintas deben tener nombres distintos.
+ *
+ * Coste: O(longitud del nombre).
+ *
+ * @param nombre Nombre del resolutor.
+ * @return Identificador del resolutor.
+ */
+uint64_t idResolutor(std::string const &nombre);
+
+/**
+ * Calcula la clave de (M, pesos, valores) con los objetos en el orden dado.
+ * Para una instancia en forma canonica es la clave canonica.
+ *
+ * Coste: O(n), n = numero de objetos.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param resolutor Identificador del resolutor (ver idResolutor).
+ * @return Clave de la instancia.
+ */
+ClaveInstancia claveInstancia(std::vector<ObjetoReal> const &objetos,
+                              double M, uint64_t resolutor);
+
+/**
+ * Calcula el orden canonico de los objetos: por peso y, a igual peso, por
+ * valor. orig[j] es el objeto original de la posicion j.
+ *
+ * Coste: O(n logn), n = numero de objetos.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param orig Objeto original de cada posicion.
+ */
+void ordenCanonico(std::vector<ObjetoReal> const &objetos,
+                   std::vector<size_t> &orig);
+
+/**
+ * Pasa la instancia a su forma canonica: ordena los objetos por peso y, a
+ * igual peso, por valor, y calcula la clave de (M, pesos, valores).
+ *
+ * Coste: O(n logn), n = numero de objetos.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param resolutor Identificador del resolutor (ver idResolutor).
+ * @param can Instancia canonica.
+ */
+void canonicaliza(std::vector<ObjetoReal> const &objetos, double M,
+                  uint64_t resolutor, InstanciaCanonica &can);
+
+/**
+ * Soluciones guardadas en un fichero de solo anyadir. Cada registro lleva
+ * la clave (con el resolutor), el numero de objetos, el valor y la
+ * solucion en bits.
+ * Al abrirlo se recorre una vez para construir el indice de claves.
+ */
+class AlmacenSoluciones {
+public:
+    AlmacenSoluciones() = default;
+
+    ~AlmacenSoluciones();
+
+    AlmacenSoluciones(AlmacenSoluciones const &) = delete;
+
+    AlmacenSoluciones &operator=(AlmacenSoluciones const &) = delete;
+
+    /**
+     * Abre (o crea) el fichero. Si no se puede, muestra un error y
+     * devuelve false; el almacen queda cerrado.
+     */
+    bool abre(std::string const &fichero);
+
+    bool abierto() const { return fd >= 0; }
+
+    /**
+     * Busca la solucion de la instancia con clave dada y n objetos.
+     * Coste: O(n) si esta, O(1) si no.
+     */
+    bool busca(ClaveInstancia const &clave, size_t n,
+               std::vector<bool> &solucion, double &valorSol);
+
+    /**
+     * Anyade la solucion al final del fichero. Coste: O(n).
+     */
+    void anyade(ClaveInstancia const &clave, std::vector<bool> const &solucion,
+                double valorSol);
+
+    size_t tamanyo() const { return indice.size(); }
+
+private:
+    void cierra();
+
+    bool proyecta(size_t bytes);
+
+    int fd = -1;
+    const unsigned char *datos = nullptr;   //Fichero proyectado
+    size_t bytesProyectados = 0, bytesFichero = 0;
+    std::unordered_map<ClaveInstancia, size_t, HashClave> indice;
+};
+
+class CacheSoluciones {
+public:
+    /**
+     * Crea una cache con capacidad soluciones en memoria. Si fichero no es
+     * vacio, las soluciones se guardan tambien en ese fichero.
+     */
+    explicit CacheSoluciones(size_t capacidad,
+                             std::string const &fichero = "");
+
+    /**
+     * Busca la solucion de la instancia con clave dada y n objetos, primero
+     * en memoria y despues en el fichero.
+     */
+    bool busca(ClaveInstancia const &clave, size_t n,
+               std::vector<bool> &solucion, double &valorSol);
+
+    /**
+     * Guarda la solucion de la instancia con clave dada y la cuenta como
+     * fallo.
+     */
+    void guarda(ClaveInstancia const &clave,
+                std::vector<bool> const &solucion, double valorSol);
+
+    /**
+     * Busca la clave canonica de la que directa es alias.
+     */
+    bool buscaAlias(ClaveInstancia const &directa, ClaveInstancia &canonica);
+
+    /**
+     * Anota directa como alias de canonica. Solo en memoria y como mucho
+     * tantos como la capacidad; al llenarse se olvidan todos.
+     */
+    void guardaAlias(ClaveInstancia const &directa,
+                     ClaveInstancia const &canonica);
+
+    //Se deben leer cuando ningun otro hilo esta usando la cache
+    long long aciertos = 0, aciertosFichero = 0;
+    long long fallos = 0;       //Instancias resueltas y guardadas
+
+private:
+    struct Entrada {
+        ClaveInstancia clave;
+        std::vector<bool> solucion;
+        double valor;
+    };
+
+    void guardaMemoria(ClaveInstancia const &clave,
+                       std::vector<bool> const &solucion, double valorSol);
+
+    size_t capacidad;
+    std::list<Entrada> lru;     //De mas a menos reciente
+    std::unordered_map<ClaveInstancia, std::list<Entrada>::iterator,
+            HashClave> mapa;
+    std::unordered_map<ClaveInstancia, ClaveInstancia, HashClave> alias;
+    AlmacenSoluciones almacen;
+    std::mutex mutex;
+};
+
+typedef std::function<void(std::vector<ObjetoReal> const &, double,
+                           std::vector<bool> &, double &)> Resolutor;
+
+/**
+ * Resuelve la instancia con resolutor salvo que su solucion ya este en la
+ * cache. La solucion se devuelve en el orden de objetos dado.
+ *
+ * Coste: O(n logn) si esta en la cache, n = numero de objetos.
+ *
+ * @param cache Cache de soluciones.
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param solucion Indica si se coge el objeto o no.
+ * @param valorSol Valor de la mochila con los objetos dados por solucion.
+ * @param resolutor Algoritmo que se usa si no esta en la cache.
+ * @param id Identificador de resolutor (ver idResolutor). Solo se
+ * devuelven soluciones guardadas con el mismo.
+ */
+void mochilaConCache(CacheSoluciones &cache,
+                     std::vector<ObjetoReal> const &objetos, double M,
+                     std::vector<bool> &solucion, double &valorSol,
+                     Resolutor const &resolutor, uint64_t id);
+
+#endif //PROBLEMAMOCHILACPP_CACHE_H
@@ -2,6 +2,9 @@
 
 #include <fstream>
 #include <chrono>
+#include <climits>
+#include <cmath>
+#include <random>
 
 /**
  * Genera un fichero de nombre nombreFichero con el tamanyo de la mochila
@@ -84,24 +87,243 @@ void leeCasoPruebaMochilaReal(std::string nombreFichero, double &M,
     in.close();
 }
 
-void leeCasoPruebaMochilaInt(std::string nombreFichero, int &M,
+/**
+ * Indica si x es un entero entre 0 e INT_MAX, es decir, si cabe en int
+ * como M o como peso sin truncarse.
+ */
+static bool cabeEnInt(double x) {
+    return x >= 0 && x <= INT_MAX && x == std::floor(x);
+}
+
+/**
+ * Igual que leeCasoPruebaMochilaReal pero con M y los pesos enteros. Si M o
+ * algun peso no es un entero entre 0 e INT_MAX muestra un error, deja la
+ * instancia vacia (M = 0, sin objetos) y devuelve false.
+ *
+ * @param nombreFichero Nombre del fichero del cual leer.
+ * @param M Tamanyo maximo de la mochila.
+ * @param objetos Vector de objetos. Se presupone vacio.
+ * @return False si no se ha podido abrir el fichero o la instancia no cabe
+ * en int.
+ */
+bool leeCasoPruebaMochilaInt(std::string nombreFichero, int &M,
                              std::vector<ObjetoInt> &objetos) {
+    M = 0;
+    objetos.clear();
     std::ifstream in;
     in.open(nombreFichero);
     if (!in.is_open()) {
         std::cout << "ERROR. No se ha podido abrir el fichero.\n";
-        return;
+        return false;
     }
 
+    //Se lee en double para ver si cabe en int antes de convertir
+    std::vector<ObjetoReal> reales;
+    double MReal;
     int nObjetos;
-    in >> M >> nObjetos;
-    objetos.resize(nObjetos);
+    in >> MReal >> nObjetos;
+    reales.resize(nObjetos);
 
     for (int i = 0; i < nObjetos; ++i) {
-        in >> objetos[i].peso >> objetos[i].valor;
+        in >> reales[i].peso >> reales[i].valor;
+    }
+
+    in.close();
+    return pasaAEntero(MReal, reales, M, objetos);
+}
+
+/**
+ * Pasa una instancia real con M y pesos enteros a ObjetoInt. Si M o algun
+ * peso no es un entero entre 0 e INT_MAX muestra un error, deja la
+ * instancia entera vacia (MInt = 0, sin objetos) y devuelve false.
+ *
+ * Coste: O(n), n = numero de objetos.
+ *
+ * @param M Tamanyo maximo de la mochila.
+ * @param objetos Vector de objetos.
+ * @param MInt Tamanyo maximo de la mochila como int.
+ * @param objetosInt Vector de objetos con el peso como int.
+ * @return False si la instancia no cabe en int.
+ */
+bool pasaAEntero(double M, std::vector<ObjetoReal> const &objetos, int &MInt,
+                 std::vector<ObjetoInt> &objetosInt) {
+    MInt = 0;
+    objetosInt.clear();
+    if (!cabeEnInt(M)) {
+        std::cout << "ERROR. M = " << M << " no es un entero entre 0 y "
+                  << INT_MAX << ".\n";
+        return false;
+    }
+    for (size_t i = 0; i < objetos.size(); ++i) {
+        if (!cabeEnInt(objetos[i].peso)) {
+            std::cout << "ERROR. El peso " << objetos[i].peso
+                      << " del objeto " << i << " no es un entero entre 0 y "
+                      << INT_MAX << ".\n";
+            return false;
+        }
+    }
+
+    MInt = (int) M;
+    objetosInt.resize(objetos.size());
+    for (size_t i = 0; i < objetos.size(); ++i)
+        objetosInt[i] = {(int) objetos[i].peso, objetos[i].valor};
+    return true;
+}
+
+/**
+ * Construye el vector de objetos a partir de un fichero binario generado
+ * por generaCasoPruebaClase: la cadena "MOCHILAB", M (double), el numero de
+ * objetos (long long) y despues el peso y el valor (double) de cada objeto.
+ * Si el fichero no tiene ese formato, el numero de objetos no es valido o
+ * el fichero se acaba antes, muestra un error, deja la instancia vacia (M =
+ * 0, sin objetos) y devuelve false.
+ *
+ * @param nombreFichero Nombre del fichero del cual leer.
+ * @param M Tamanyo maximo de la mochila.
+ * @param objetos Vector de objetos. Se presupone vacio.
+ * @return False si no se ha podido leer la instancia.
+ */
+bool leeCasoPruebaMochilaBin(std::string nombreFichero, double &M,
+                             std::vector<ObjetoReal> &objetos) {
+    M = 0;
+    objetos.clear();
+    std::ifstream in;
+    in.open(nombreFichero, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) {
+        std::cout << "ERROR. No se ha podido abrir el fichero.\n";
+        return false;
+    }
+    const long long tam = (long long) in.tellg();
+    in.seekg(0);
+
+    char magia[8];
+    double MLeido;
+    long long nObjetos;
+    const long long cabecera = sizeof(magia) + sizeof(MLeido) +
+                               sizeof(nObjetos);
+    if (!in.read(magia, sizeof(magia)) ||
+        std::string(magia, sizeof(magia)) != "MOCHILAB" ||
+        !in.read((char *) &MLeido, sizeof(MLeido)) ||
+        !in.read((char *) &nObjetos, sizeof(nObjetos))) {
+        std::cout << "ERROR. El fichero no es una instancia binaria.\n";
+        return false;
+    }
+    if (nObjetos < 0) {
+        std::cout << "ERROR. El numero de objetos " << nObjetos
+                  << " no es valido.\n";
+        return false;
+    }
+    if (nObjetos > (tam - cabecera) / (long long) sizeof(ObjetoReal)) {
+        std::cout << "ERROR. El fichero no tiene los " << nObjetos
+                  << " objetos que indica.\n";
+        return false;
+    }
+
+    //Cada objeto son dos double seguidos, igual que en ObjetoReal
+    objetos.resize((size_t) nObjetos);
+    if (!in.read((char *) objetos.data(), nObjetos * sizeof(ObjetoReal))) {
+        std::cout << "ERROR. El fichero se acaba antes de los objetos.\n";
+        objetos.clear();
+        return false;
+    }
+
+    in.close();
+    M = MLeido;
+    return true;
+}
+
+/**
+ * Guarda los parametros del algoritmo genetico en nombreFichero, uno por
+ * linea con el formato "nombre valor".
+ *
+ * @param nombreFichero Nombre del fichero donde guardar los datos.
+ * @param config Parametros del algoritmo genetico.
+ */
+void guardaConfigGenetico(std::string const &nombreFichero,
+                          ConfigGenetico const &config) {
+    std::ofstream out;
+    out.open(nombreFichero);
+    if (!out.is_open()) {
+        std::cout << "ERROR. No se ha podido abrir el fichero.\n";
+        return;
+    }
+
+    out.precision(15);
+    out << "maxGeneraciones " << config.maxGeneraciones << '\n'
+        << "tamPobl " << config.tamPobl << '\n'
+        << "tamUlt " << config.tamUlt << '\n'
+        << "probMutacion " << config.probMutacion << '\n'
+        << "porcMutacion " << config.porcMutacion << '\n'
+        << "probCruce " << config.probCruce << '\n'
+        << "probElitismo " << config.probElitismo << '\n'
+        << "probBusquedaLocal " << config.probBusquedaLocal << '\n'
+        << "prob1Cuartil " << config.prob1Cuartil << '\n'
+        << "prob2Cuartil " << config.prob2Cuartil << '\n'
+        << "prob3Cuartil " << config.prob3Cuartil << '\n'
+        << "semilla " << config.semilla << '\n'
+        << "objetivo " << config.objetivo << '\n'
+        << "tiempoMax " << config.tiempoMax << '\n';
+
+    out.close();
+}
+
+/**
+ * Lee los parametros del algoritmo genetico de un fichero escrito por
+ * guardaConfigGenetico. Los parametros que no aparecen en el fichero
+ * mantienen el valor que tuvieran en config.
+ *
+ * @param nombreFichero Nombre del fichero del cual leer.
+ * @param config Parametros del algoritmo genetico.
+ * @return False si no se ha podido abrir el fichero o tiene algun
+ * parametro desconocido.
+ */
+bool leeConfigGenetico(std::string const &nombreFichero,
+                       ConfigGenetico &config) {
+    std::ifstream in;
+    in.open(nombreFichero);
+    if (!in.is_open()) {
+        std::cout << "ERROR. No se ha podido abrir el fichero.\n";
+        return false;
+    }
+
+    std::string nombre;
+    while (in >> nombre) {
+        if (nombre == "maxGeneraciones")
+            in >> config.maxGeneraciones;
+        else if (nombre == "tamPobl")
+            in >> config.tamPobl;
+        else if (nombre == "tamUlt")
+            in >> config.tamUlt;
+        else if (nombre == "probMutacion")
+            in >> config.probMutacion;
+        else if (nombre == "porcMutacion")
+            in >> config.porcMutacion;
+        else if (nombre == "probCruce")
+            in >> config.probCruce;
+        else if (nombre == "probElitismo")
+            in >> config.probElitismo;
+        else if (nombre == "probBusquedaLocal")
+            in >> config.probBusquedaLocal;
+        else if (nombre == "prob1Cuartil")
+            in >> config.prob1Cuartil;
+        else if (nombre == "prob2Cuartil")
+            in >> config.prob2Cuartil;
+        else if (nombre == "prob3Cuartil")
+            in >> config.prob3Cuartil;
+        else if (nombre == "semilla")
+            in >> config.semilla;
+        else if (nombre == "objetivo")
+            in >> config.objetivo;
+        else if (nombre == "tiempoMax")
+            in >> config.tiempoMax;
+        else {
+            std::cout << "ERROR. Parametro desconocido: " << nombre << '\n';
+            return false;
+        }
     }
 
     in.close();
+    return true;
 }
 
 void casoPruebaVoraz() {
@@ -181,6 +403,31 @@ void casoPruebaProgDin() {
                       N_IT_CASO_GR);*/
 }
 
+void casoPruebaProgDinDispersa() {
+    std::cout << "-----CASO PRUEBA PROG DIN DISPERSA-----\n";
+/*
+    casoPruebaProgDinDispersa("Caso Prueba Real 1000A",
+                              "CasoPruebaReal1000A.txt", N_IT_CASO_PEQ);
+    casoPruebaProgDinDispersa("Caso Prueba Real 1000B",
+                              "CasoPruebaReal1000B.txt", N_IT_CASO_PEQ);
+    casoPruebaProgDinDispersa("Caso Prueba Real 1000C",
+                              "CasoPruebaReal1000C.txt", N_IT_CASO_PEQ);
+*/
+    casoPruebaProgDinDispersa("Caso Prueba Real 100000A",
+                              "CasoPruebaReal100000A.txt", N_IT_CASO_GR);
+    casoPruebaProgDinDispersa("Caso Prueba Real 100000B",
+                              "CasoPruebaReal100000B.txt", N_IT_CASO_GR);
+    casoPruebaProgDinDispersa("Caso Prueba Real 100000C",
+                              "CasoPruebaReal100000C.txt", N_IT_CASO_GR);
+
+    casoPruebaProgDinDispersa("Caso Prueba Int 1000000A",
+                              "CasoPruebaInt1000000A.txt", N_IT_CASO_GR);
+    casoPruebaProgDinDispersa("Caso Prueba Int 1000000B",
+                              "CasoPruebaInt1000000B.txt", N_IT_CASO_GR);
+    casoPruebaProgDinDispersa("Caso Prueba Int 1000000C",
+                              "CasoPruebaInt1000000C.txt", N_IT_CASO_GR);
+}
+
 void casoPruebaRamPoda() {
     std::cout << "-----CASO PRUEBA RAM PODA-----\n";
 /*
@@ -281,25 +528,26 @@ void casoPruebaGenetico() {
     casoPruebaGenetico("Caso Prueba 1000000C", "CasoPruebaReal1000000C.txt",
                        N_IT_GEN);*/
 
-    MAX_GENERACIONES = 2000;
-    TAM_ULT = 30;
-    PROB_CRUCE = 0.95;
-    PROB_ELITISMO = 0.05;
+    ConfigGenetico paramB;
+    paramB.maxGeneraciones = 2000;
+    paramB.tamUlt = 30;
+    paramB.probCruce = 0.95;
+    paramB.probElitismo = 0.05;
 
     std::cout << "=======PARAM B===========\n";
     casoPruebaGenetico("Caso Prueba 100000A", "CasoPruebaReal100000A.txt",
-                       N_IT_GEN);
+                       N_IT_GEN, paramB);
     casoPruebaGenetico("Caso Prueba 100000B", "CasoPruebaReal100000B.txt",
-                       N_IT_GEN);
+                       N_IT_GEN, paramB);
     casoPruebaGenetico("Caso Prueba 100000C", "CasoPruebaReal100000C.txt",
-                       N_IT_GEN);
+                       N_IT_GEN, paramB);
 /*
     casoPruebaGenetico("Caso Prueba 1000000A", "CasoPruebaReal1000000A.txt",
-                       N_IT_GEN);
+                       N_IT_GEN, paramB);
     casoPruebaGenetico("Caso Prueba 1000000B", "CasoPruebaReal1000000B.txt",
-                       N_IT_GEN);
+                       N_IT_GEN, paramB);
     casoPruebaGenetico("Caso Prueba 1000000C", "CasoPruebaReal1000000C.txt",
-                       N_IT_GEN);*/
+                       N_IT_GEN, paramB);*/
 }
 
 /**
@@ -323,7 +571,8 @@ nombreFichero, const int nIt) {
 
         leeCasoPruebaMochilaReal(nombreFichero, M, objetos);
 
-        std::vector<double> solucion(objetos.size());
+        //Solo se coge una pequenya parte de los objetos
+        SolucionDispersa solucion;
 
         auto t1 = std::chrono::steady_clock::now();
 
@@ -350,7 +599,8 @@ nombreFichero, const int nIt) {
     std::cout << casoPrueba << "\n";
     for (int i = 1; i <= nIt; ++i) {
 
-        leeCasoPruebaMochilaInt(nombreFichero, M, objetos);
+        if (!leeCasoPruebaMochilaInt(nombreFichero, M, objetos))
+            return;
 
         std::vector<bool> solucion(objetos.size());
 
@@ -369,6 +619,85 @@ nombreFichero, const int nIt) {
     std::cout << "-------------------------------\n";
 }
 
+/**
+ * Comprueba que mochilaProgDin con un limite de memoria en el que caben la
+ * fila y la matriz en fichero, pero no los anillos de los bloques, sigue
+ * dando la optima (la de un objeto por pasada sin limite) y anota la
+ * degradacion. La instancia se genera con una semilla fija.
+ *
+ * @return True si da la optima.
+ */
+bool casoPruebaProgDinLimite() {
+    std::cout << "-----CASO PRUEBA PROG DIN CON LIMITE-----\n";
+    const int M = 200000, nObjetos = 40;
+    std::mt19937 gen(12345);
+    std::uniform_int_distribution<int> peso(1000, 20000), valor(1, 1000);
+    std::vector<ObjetoInt> objetos(nObjetos);
+    for (ObjetoInt &o : objetos) {
+        o.peso = peso(gen);
+        o.valor = valor(gen);
+    }
+
+    std::vector<bool> solucion(objetos.size());
+    double optimo, valorSol;
+    OpcionesProgDin opciones;
+    opciones.objetosPorBloque = 1;
+    mochilaProgDin(objetos, M, solucion, optimo, nullptr, opciones);
+
+    //La fila, el orden y 200 KB: los anillos necesitan hasta 1 MB
+    ContadorMemoria memoria(((size_t) M + 1) * sizeof(double) +
+                            nObjetos * sizeof(size_t) + 200 * 1024);
+    opciones = OpcionesProgDin();
+    opciones.memoria = &memoria;
+    mochilaProgDin(objetos, M, solucion, valorSol, nullptr, opciones);
+
+    double valorCogidos = 0;
+    long long pesoCogidos = 0;
+    for (size_t i = 0; i < objetos.size(); ++i) {
+        if (solucion[i]) {
+            valorCogidos += objetos[i].valor;
+            pesoCogidos += objetos[i].peso;
+        }
+    }
+    std::cout << "Optima: " << optimo << " Con limite: " << valorSol
+              << " Degradaciones: " << memoria.degradaciones << '\n';
+    if (valorSol != optimo || valorCogidos != optimo || pesoCogidos > M) {
+        std::cout << "ERROR. Con limite de memoria no se obtiene la "
+                     "optima.\n";
+        return false;
+    }
+    std::cout << "-------------------------------\n";
+    return true;
+}
+
+void casoPruebaProgDinDispersa(std::string const &casoPrueba, std::string
+const &nombreFichero, const int nIt) {
+    std::vector<ObjetoReal> objetos;
+    double M;
+    double valorSol;
+
+    std::cout << casoPrueba << "\n";
+    for (int i = 1; i <= nIt; ++i) {
+
+        leeCasoPruebaMochilaReal(nombreFichero, M, objetos);
+
+        std::vector<bool> solucion(objetos.size());
+
+        auto t1 = std::chrono::steady_clock::now();
+
+        mochilaProgDinDispersa(objetos, M, solucion, valorSol);
+
+        auto t2 = std::chrono::steady_clock::now();
+        auto time_span = std::chrono::duration_cast<std::chrono::duration<double>>(
+                t2 - t1);
+
+        std::cout << "Vuelta: " << i << " ValorSol: " << valorSol << '\n';
+        std::cout << "El algoritmo ha tardado " << time_span.count()
+                  << " segundos.\n";
+    }
+    std::cout << "-------------------------------\n";
+}
+
 void casoPruebaRamPoda(std::string const &casoPrueba, std::string const &
 nombreFichero, const int nIt) {
     std::vector<ObjetoReal> objetos;
@@ -400,7 +729,7 @@ nombreFichero, const int nIt) {
 }
 
 void casoPruebaGenetico(std::string const &casoPrueba, std::string const &
-nombreFichero, const int nIt) {
+nombreFichero, const int nIt, ConfigGenetico const &config) {
     std::vector<ObjetoReal> objetos;
     double M;
     double valorSol;
@@ -414,7 +743,7 @@ nombreFichero, const int nIt) {
 
         auto t1 = std::chrono::steady_clock::now();
 
-        mochilaGenetico(objetos, M, solucion, valorSol);
+        mochilaGenetico(objetos, M, solucion, valorSol, nullptr, config);
 
         auto t2 = std::chrono::steady_clock::now();
         auto time_span = std::chrono::duration_cast<std::chrono::duration<double>>(
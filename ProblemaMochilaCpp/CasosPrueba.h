@@ -50,9 +50,75 @@ void generaCasoPruebaMochilaInt(std::string nombreFichero, int nObjetos,
 void leeCasoPruebaMochilaReal(std::string nombreFichero, double &M,
                               std::vector<ObjetoReal> &objetos);
 
-void leeCasoPruebaMochilaInt(std::string nombreFichero, int &M,
+/**
+ * Igual que leeCasoPruebaMochilaReal pero con M y los pesos enteros. Si M o
+ * algun peso no es un entero entre 0 e INT_MAX muestra un error, deja la
+ * instancia vacia (M = 0, sin objetos) y devuelve false.
+ *
+ * @param nombreFichero Nombre del fichero del cual leer.
+ * @param M Tamanyo maximo de la mochila.
+ * @param objetos Vector de objetos. Se presupone vacio.
+ * @return False si no se ha podido abrir el fichero o la instancia no cabe
+ * en int.
+ */
+bool leeCasoPruebaMochilaInt(std::string nombreFichero, int &M,
                              std::vector<ObjetoInt> &objetos);
 
+/**
+ * Pasa una instancia real con M y pesos enteros a ObjetoInt. Si M o algun
+ * peso no es un entero entre 0 e INT_MAX muestra un error, deja la
+ * instancia entera vacia (MInt = 0, sin objetos) y devuelve false.
+ *
+ * Coste: O(n), n = numero de objetos.
+ *
+ * @param M Tamanyo maximo de la mochila.
+ * @param objetos Vector de objetos.
+ * @param MInt Tamanyo maximo de la mochila como int.
+ * @param objetosInt Vector de objetos con el peso como int.
+ * @return False si la instancia no cabe en int.
+ */
+bool pasaAEntero(double M, std::vector<ObjetoReal> const &objetos, int &MInt,
+                 std::vector<ObjetoInt> &objetosInt);
+
+/**
+ * Construye el vector de objetos a partir de un fichero binario generado
+ * por generaCasoPruebaClase: la cadena "MOCHILAB", M (double), el numero de
+ * objetos (long long) y despues el peso y el valor (double) de cada objeto.
+ * Si el fichero no tiene ese formato, el numero de objetos no es valido o
+ * el fichero se acaba antes, muestra un error, deja la instancia vacia (M =
+ * 0, sin objetos) y devuelve false.
+ *
+ * @param nombreFichero Nombre del fichero del cual leer.
+ * @param M Tamanyo maximo de la mochila.
+ * @param objetos Vector de objetos. Se presupone vacio.
+ * @return False si no se ha podido leer la instancia.
+ */
+bool leeCasoPruebaMochilaBin(std::string nombreFichero, double &M,
+                             std::vector<ObjetoReal> &objetos);
+
+/**
+ * Guarda los parametros del algoritmo genetico en nombreFichero, uno por
+ * linea con el formato "nombre valor".
+ *
+ * @param nombreFichero Nombre del fichero donde guardar los datos.
+ * @param config Parametros del algoritmo genetico.
+ */
+void guardaConfigGenetico(std::string const &nombreFichero,
+                          ConfigGenetico const &config);
+
+/**
+ * Lee los parametros del algoritmo genetico de un fichero escrito por
+ * guardaConfigGenetico. Los parametros que no aparecen en el fichero
+ * mantienen el valor que tuvieran en config.
+ *
+ * @param nombreFichero Nombre del fichero del cual leer.
+ * @param config Parametros del algoritmo genetico.
+ * @return False si no se ha podido abrir el fichero o tiene algun
+ * parametro desconocido.
+ */
+bool leeConfigGenetico(std::string const &nombreFichero,
+                       ConfigGenetico &config);
+
 void casoPruebaVoraz();
 void casoPruebaVoraz(std::string const &casoPrueba, std::string const &
 nombreFichero, const int nIt);
@@ -61,12 +127,25 @@ void casoPruebaProgDin();
 void casoPruebaProgDin(std::string const &casoPrueba, std::string const &
 nombreFichero, const int nIt);
 
+/**
+ * Comprueba que mochilaProgDin da la optima con un limite de memoria en el
+ * que no caben los anillos de los bloques.
+ *
+ * @return True si da la optima.
+ */
+bool casoPruebaProgDinLimite();
+
+void casoPruebaProgDinDispersa();
+void casoPruebaProgDinDispersa(std::string const &casoPrueba, std::string
+const &nombreFichero, const int nIt);
+
 void casoPruebaRamPoda();
 void casoPruebaRamPoda(std::string const &casoPrueba, std::string const &
 nombreFichero, const int nIt);
 
 void casoPruebaGenetico();
 void casoPruebaGenetico(std::string const &casoPrueba, std::string const &
-nombreFichero, const int nIt);
+nombreFichero, const int nIt,
+                        ConfigGenetico const &config = ConfigGenetico());
 
 #endif //PROBLEMAMOCHILACPP_CASOSPRUEBA_H
@@ -0,0 +1,231 @@
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "CasosPrueba.h"
+#include "Estadisticas.h"
+#include "Protocolo.h"
+
+/*
+ * Generador de carga para Servidor: abre varias conexiones, envia por cada
+ * una peticiones sin esperar las respuestas (hasta ventana pendientes a la
+ * vez) y mide la latencia de cada peticion y las peticiones por segundo.
+ * Comprueba ademas que cada solucion recibida cabe en la mochila y que su
+ * valor es el indicado.
+ *
+ * Uso: Cliente [-a algoritmo] [-c conexiones] [-p peticiones] [-v ventana]
+ *              [-n objetos] [-d distintas] [-s semilla] socket [fichero]
+ *
+ * Las peticiones son todas la instancia del fichero o, si no se da, se
+ * reparten entre varias instancias aleatorias no correlacionadas.
+ */
+
+struct Instancia {
+    double M;
+    std::vector<ObjetoReal> objetos;
+};
+
+void muestraUso() {
+    std::cout << "Uso: Cliente [-a algoritmo] [-c conexiones] "
+                 "[-p peticiones] [-v ventana] [-n objetos] [-d distintas] "
+                 "[-s semilla] socket [fichero]\nAlgoritmos:";
+    for (const char *nombre : NOMBRES_ALGORITMOS)
+        std::cout << ' ' << nombre;
+    std::cout << '\n';
+}
+
+/**
+ * Comprueba que la solucion cabe en la mochila y vale lo indicado.
+ */
+bool compruebaSolucion(Instancia const &ins, std::vector<bool> const &sol,
+                       double valor) {
+    if (sol.size() != ins.objetos.size())
+        return false;
+    double peso = 0, valorSol = 0;
+    for (size_t i = 0; i < sol.size(); ++i) {
+        if (sol[i]) {
+            peso += ins.objetos[i].peso;
+            valorSol += ins.objetos[i].valor;
+        }
+    }
+    return peso <= ins.M && valorSol <= valor + 1e-6 * (1 + valor) &&
+           valorSol >= valor - 1e-6 * (1 + valor);
+}
+
+/**
+ * Envia nPeticiones por una conexion nueva y guarda la latencia de cada una
+ * en segundos.
+ *
+ * @return Numero de respuestas erroneas, o -1 si no se ha podido conectar.
+ */
+long long cargaConexion(sockaddr_un const &dir,
+                        std::vector<Instancia> const &instancias,
+                        AlgoritmoPeticion algoritmo, long long nPeticiones,
+                        int ventana, long long primera,
+                        std::vector<double> &latencias) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (sockaddr const *) &dir, sizeof dir) != 0) {
+        if (fd >= 0)
+            close(fd);
+        return -1;
+    }
+
+    std::vector<std::chrono::steady_clock::time_point> envio(nPeticiones);
+    long long enviadas = 0, recibidas = 0, errores = 0;
+    std::vector<bool> sol;
+    while (recibidas < nPeticiones) {
+        while (enviadas < nPeticiones && enviadas - recibidas < ventana) {
+            Instancia const &ins =
+                    instancias[(primera + enviadas) % instancias.size()];
+            envio[enviadas] = std::chrono::steady_clock::now();
+            if (!enviaPeticion(fd, (uint64_t) enviadas, algoritmo,
+                               ins.objetos, ins.M))
+                break;
+            enviadas++;
+        }
+
+        CabeceraRespuesta cab;
+        if (!recibeRespuesta(fd, cab, sol) || cab.id >= (uint64_t) enviadas) {
+            errores += nPeticiones - recibidas;
+            break;
+        }
+        auto t = std::chrono::steady_clock::now();
+        latencias.push_back(
+                std::chrono::duration<double>(t - envio[cab.id]).count());
+        Instancia const &ins =
+                instancias[(primera + cab.id) % instancias.size()];
+        if (cab.estado != RESP_OK || !compruebaSolucion(ins, sol, cab.valor))
+            errores++;
+        recibidas++;
+    }
+    close(fd);
+    return errores;
+}
+
+int main(int argc, char *argv[]) {
+    AlgoritmoPeticion algoritmo = PET_RAMPODA;
+    int nConexiones = 4, ventana = 8, nDistintas = 16;
+    long long nPeticiones = 10000, nObjetos = 100;
+    unsigned int semilla = 1;
+    std::string ruta, fichero;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg[0] == '-' && i + 1 < argc) {
+            std::string valor = argv[++i];
+            if (arg == "-a") {
+                bool encontrado = false;
+                for (int a = 0; a < (int) NUM_ALGORITMOS_PETICION; ++a) {
+                    if (valor == NOMBRES_ALGORITMOS[a]) {
+                        algoritmo = (AlgoritmoPeticion) a;
+                        encontrado = true;
+                    }
+                }
+                if (!encontrado) {
+                    muestraUso();
+                    return 1;
+                }
+            } else if (arg == "-c") {
+                nConexiones = std::atoi(valor.c_str());
+            } else if (arg == "-p") {
+                nPeticiones = std::atoll(valor.c_str());
+            } else if (arg == "-v") {
+                ventana = std::atoi(valor.c_str());
+            } else if (arg == "-n") {
+                nObjetos = std::atoll(valor.c_str());
+            } else if (arg == "-d") {
+                nDistintas = std::atoi(valor.c_str());
+            } else if (arg == "-s") {
+                semilla = (unsigned int) std::atoi(valor.c_str());
+            } else {
+                muestraUso();
+                return 1;
+            }
+        } else if (arg[0] != '-' && ruta.empty()) {
+            ruta = arg;
+        } else if (arg[0] != '-' && fichero.empty()) {
+            fichero = arg;
+        } else {
+            muestraUso();
+            return 1;
+        }
+    }
+    sockaddr_un dir;
+    if (ruta.empty() || !direccionSocket(ruta.c_str(), dir) ||
+        nConexiones < 1 || nPeticiones < 1 || ventana < 1 || nObjetos < 0 ||
+        nDistintas < 1) {
+        muestraUso();
+        return 1;
+    }
+
+    //Preparamos las instancias antes de empezar a medir
+    std::vector<Instancia> instancias;
+    if (!fichero.empty()) {
+        instancias.resize(1);
+        leeCasoPruebaMochilaReal(fichero, instancias[0].M,
+                                 instancias[0].objetos);
+    } else {
+        std::mt19937 gen(semilla);
+        std::uniform_int_distribution<int> dist(1, 1000);
+        instancias.resize(nDistintas);
+        for (Instancia &ins : instancias) {
+            double sumaPesos = 0;
+            ins.objetos.resize(nObjetos);
+            for (ObjetoReal &o : ins.objetos) {
+                o.peso = dist(gen);
+                o.valor = dist(gen);
+                sumaPesos += o.peso;
+            }
+            ins.M = sumaPesos / 2;
+        }
+    }
+
+    //Repartimos las peticiones entre las conexiones
+    std::vector<std::vector<double>> latencias(nConexiones);
+    std::vector<long long> errores(nConexiones);
+    std::vector<std::thread> hilos;
+    auto t1 = std::chrono::steady_clock::now();
+    for (int c = 0; c < nConexiones; ++c) {
+        long long primera = nPeticiones * c / nConexiones;
+        long long cuantas = nPeticiones * (c + 1) / nConexiones - primera;
+        hilos.emplace_back([&, c, primera, cuantas]() {
+            errores[c] = cargaConexion(dir, instancias, algoritmo, cuantas,
+                                       ventana, primera, latencias[c]);
+        });
+    }
+    for (std::thread &h : hilos)
+        h.join();
+    auto t2 = std::chrono::steady_clock::now();
+    double segundos = std::chrono::duration<double>(t2 - t1).count();
+
+    std::vector<double> todas;
+    long long totalErrores = 0;
+    for (int c = 0; c < nConexiones; ++c) {
+        if (errores[c] < 0) {
+            std::cout << "ERROR. No se ha podido conectar con " << ruta
+                      << '\n';
+            return 1;
+        }
+        totalErrores += errores[c];
+        todas.insert(todas.end(), latencias[c].begin(), latencias[c].end());
+    }
+    if (todas.empty()) {
+        std::cout << "ERROR. No se ha recibido ninguna respuesta.\n";
+        return 1;
+    }
+
+    ResumenTiempos r;
+    resumeTiempos(todas, r);
+    std::cout << todas.size() << " respuestas en " << segundos
+              << " segundos: " << todas.size() / segundos
+              << " peticiones/s, " << totalErrores << " erroneas.\n"
+              << "Latencia: mediana " << r.mediana * 1e6 << " us, p90 "
+              << r.p90 * 1e6 << " us, p99 " << r.p99 * 1e6 << " us, max "
+              << r.maximo * 1e6 << " us\n";
+    return totalErrores == 0 ? 0 : 1;
+}
@@ -0,0 +1,234 @@
+#ifndef PROBLEMAMOCHILACPP_COLANODOS_H
+#define PROBLEMAMOCHILACPP_COLANODOS_H
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+#include "Memoria.h"
+
+/*
+ * Estructuras para la lista de nodos vivos de la ramificacion y poda. Los
+ * nodos son de tamanyo fijo y viven en un almacen (PoolNodos) que reutiliza
+ * los huecos de los nodos ya extraidos, asi que tras los primeros niveles no
+ * se pide memoria por nodo. La cola de prioridad (ColaNodos) es un monticulo
+ * 4-ario que solo mueve pares (cota, indice del nodo). La solucion parcial
+ * no se copia en cada nodo: cada nodo apunta a su ultima decision de coger
+ * un objeto en un historial compartido (ver Decision en Algoritmos.h).
+ *
+ * Los nodos cuya cota queda por debajo de la mejor solucion no se quitan
+ * uno a uno: cuando la mejor solucion sube, ColaNodos::poda los saca de la
+ * cola de una vez y devuelve sus huecos al almacen.
+ *
+ * Los dos pueden anotar su memoria en un ContadorMemoria (ver Memoria.h);
+ * si tiene limite, nuevo, inserta y reserva lanzan std::bad_alloc al
+ * superarlo. Con reserva se puede pedir la memoria de un paso de la
+ * busqueda antes de empezarlo, para no quedarse a medias.
+ */
+
+struct NodoRamPoda {
+    int k;
+    double pesoAc, valorAc;
+    size_t hist;    //Ultima decision de coger un objeto en el historial
+};
+
+class PoolNodos {
+public:
+    /**
+     * Crea un almacen vacio. Cada nodo tiene ademas nExtra doubles
+     * contiguos para datos de tamanyo fijo por instancia (por ejemplo, el
+     * peso acumulado en cada dimension). Si memoria no es nullptr se anota
+     * en ella lo que ocupa.
+     */
+    explicit PoolNodos(size_t nExtra = 0, ContadorMemoria *memoria = nullptr)
+            : nExtra(nExtra), nodos(memoria), extras(memoria),
+              libres(memoria) {}
+
+    /**
+     * Devuelve el indice de un nodo libre. Coste: O(1) amortizado.
+     */
+    size_t nuevo() {
+        if (!libres.empty()) {
+            size_t h = libres.back();
+            libres.pop_back();
+            return h;
+        }
+        reserva(1);
+        nodos.emplace_back();
+        extras.resize(extras.size() + nExtra);
+        return nodos.size() - 1;
+    }
+
+    /**
+     * Se asegura de que se pueden pedir cuantos nodos mas sin reservar
+     * memoria. Si no cabe lanza std::bad_alloc y los nodos no cambian.
+     * Coste: O(1) amortizado.
+     */
+    void reserva(size_t cuantos) {
+        if (libres.size() >= cuantos)
+            return;
+        const size_t total = nodos.size() + cuantos - libres.size();
+        if (total <= nodos.capacity() && total <= libres.capacity() &&
+            total * nExtra <= extras.capacity())
+            return;
+        const size_t cap = std::max(2 * nodos.capacity(), total);
+        nodos.reserve(cap);
+        extras.reserve(cap * nExtra);
+        libres.reserve(cap);    //Asi libera nunca pide memoria
+    }
+
+    /**
+     * Marca el nodo h como libre para reutilizarlo. No pide memoria.
+     * Coste: O(1).
+     */
+    void libera(size_t h) {
+        libres.push_back(h);
+    }
+
+    NodoRamPoda &operator[](size_t h) {
+        return nodos[h];
+    }
+
+    double *extra(size_t h) {
+        return extras.data() + h * nExtra;
+    }
+
+    /**
+     * Numero de nodos que se han llegado a tener a la vez.
+     */
+    size_t capacidad() const {
+        return nodos.size();
+    }
+
+private:
+    size_t nExtra;
+    VectorContado<NodoRamPoda> nodos;
+    VectorContado<double> extras;
+    VectorContado<size_t> libres;
+};
+
+class ColaNodos {
+public:
+    /**
+     * Crea una cola vacia. Si memoria no es nullptr se anota en ella lo que
+     * ocupa.
+     */
+    explicit ColaNodos(ContadorMemoria *memoria = nullptr)
+            : monticulo(memoria) {}
+
+    bool vacia() const {
+        return monticulo.empty();
+    }
+
+    size_t tamanyo() const {
+        return monticulo.size();
+    }
+
+    /**
+     * Cota del nodo con mayor prioridad. Coste: O(1).
+     */
+    double claveMax() const {
+        return monticulo[0].clave;
+    }
+
+    /**
+     * Se asegura de que caben cuantos nodos mas sin pedir memoria. Si no
+     * cabe lanza std::bad_alloc y la cola no cambia. Coste: O(1)
+     * amortizado.
+     */
+    void reserva(size_t cuantos) {
+        if (monticulo.capacity() - monticulo.size() < cuantos)
+            monticulo.reserve(std::max(2 * monticulo.capacity(),
+                                       monticulo.size() + cuantos));
+    }
+
+    /**
+     * Anyade el nodo con la prioridad dada. Coste: O(log_4 m), m = tamanyo.
+     */
+    void inserta(double clave, size_t nodo) {
+        size_t i = monticulo.size();
+        monticulo.push_back({clave, nodo});
+        Entrada e = monticulo[i];
+        while (i > 0 && monticulo[(i - 1) / ARIDAD].clave < e.clave) {
+            monticulo[i] = monticulo[(i - 1) / ARIDAD];
+            i = (i - 1) / ARIDAD;
+        }
+        monticulo[i] = e;
+    }
+
+    /**
+     * Quita el nodo de mayor prioridad y lo devuelve. Coste: O(4 log_4 m),
+     * m = tamanyo.
+     */
+    size_t extrae() {
+        size_t nodo = monticulo[0].nodo;
+        Entrada e = monticulo.back();
+        monticulo.pop_back();
+        if (!monticulo.empty())
+            hunde(0, e);
+        return nodo;
+    }
+
+    /**
+     * Quita los nodos con clave < cota y devuelve sus huecos al almacen. El
+     * monticulo se rehace en su sitio, sin pedir memoria. Coste: O(m),
+     * m = tamanyo.
+     */
+    void poda(double cota, PoolNodos &nodos) {
+        //Los vivos al principio, los podados al final
+        size_t vivos = 0;
+        for (size_t i = 0; i < monticulo.size(); ++i)
+            if (monticulo[i].clave >= cota)
+                std::swap(monticulo[vivos++], monticulo[i]);
+
+        for (size_t i = vivos; i < monticulo.size(); ++i)
+            nodos.libera(monticulo[i].nodo);
+        monticulo.erase(monticulo.begin() + vivos, monticulo.end());
+
+        //Hundimos los nodos con hijos, del ultimo a la raiz
+        for (size_t i = (vivos + ARIDAD - 2) / ARIDAD; i-- > 0;)
+            hunde(i, monticulo[i]);
+    }
+
+    /**
+     * Nodo de la posicion i del monticulo, i < tamanyo, sin orden concreto.
+     */
+    size_t nodo(size_t i) const {
+        return monticulo[i].nodo;
+    }
+
+private:
+    static const size_t ARIDAD = 4;
+
+    struct Entrada {
+        double clave;
+        size_t nodo;
+    };
+
+    /**
+     * Coloca e en la posicion i o por debajo, subiendo los hijos mayores.
+     */
+    void hunde(size_t i, Entrada e) {
+        const size_t m = monticulo.size();
+        while (true) {
+            size_t primero = i * ARIDAD + 1;
+            if (primero >= m)
+                break;
+            size_t mejor = primero;
+            size_t ultimo = primero + ARIDAD < m ? primero + ARIDAD : m;
+            for (size_t h = primero + 1; h < ultimo; ++h)
+                if (monticulo[h].clave > monticulo[mejor].clave)
+                    mejor = h;
+            if (monticulo[mejor].clave <= e.clave)
+                break;
+            monticulo[i] = monticulo[mejor];
+            i = mejor;
+        }
+        monticulo[i] = e;
+    }
+
+    VectorContado<Entrada> monticulo;
+};
+
+#endif //PROBLEMAMOCHILACPP_COLANODOS_H
@@ -0,0 +1,57 @@
+#include "Estadisticas.h"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * Calcula el percentil p (en [0, 100]) de un vector ordenado usando el
+ * criterio del rango mas cercano.
+ *
+ * Coste: O(1).
+ *
+ * @param ordenados Muestras ordenadas de menor a mayor. No vacio.
+ * @param p Percentil a calcular.
+ * @return Valor del percentil.
+ */
+double percentil(std::vector<double> const &ordenados, double p) {
+    size_t rango = (size_t) std::ceil(p / 100.0 * ordenados.size());
+    if (rango == 0)
+        rango = 1;
+    return ordenados[std::min(rango, ordenados.size()) - 1];
+}
+
+/**
+ * Resume un conjunto de tiempos: minimo, maximo, media, varianza muestral,
+ * desviacion tipica, mediana y percentiles 90 y 99.
+ *
+ * Coste: O(n logn), n = numero de muestras.
+ *
+ * @param tiempos Muestras a resumir. No vacio.
+ * @param r Resumen de las muestras.
+ */
+void resumeTiempos(std::vector<double> tiempos, ResumenTiempos &r) {
+    const size_t n = tiempos.size();
+    std::sort(tiempos.begin(), tiempos.end());
+
+    r.muestras = n;
+    r.minimo = tiempos.front();
+    r.maximo = tiempos.back();
+
+    double suma = 0;
+    for (double t : tiempos)
+        suma += t;
+    r.media = suma / n;
+
+    double sumaCuad = 0;
+    for (double t : tiempos)
+        sumaCuad += (t - r.media) * (t - r.media);
+    r.varianza = n > 1 ? sumaCuad / (n - 1) : 0;
+    r.desviacion = std::sqrt(r.varianza);
+
+    if (n % 2 == 1)
+        r.mediana = tiempos[n / 2];
+    else
+        r.mediana = (tiempos[n / 2 - 1] + tiempos[n / 2]) / 2;
+    r.p90 = percentil(tiempos, 90);
+    r.p99 = percentil(tiempos, 99);
+}
@@ -0,0 +1,37 @@
+#ifndef PROBLEMAMOCHILACPP_ESTADISTICAS_H
+#define PROBLEMAMOCHILACPP_ESTADISTICAS_H
+
+#include <vector>
+#include <cstddef>
+
+struct ResumenTiempos {
+    size_t muestras;
+    double minimo, maximo;
+    double media, varianza, desviacion;
+    double mediana, p90, p99;
+};
+
+/**
+ * Calcula el percentil p (en [0, 100]) de un vector ordenado usando el
+ * criterio del rango mas cercano.
+ *
+ * Coste: O(1).
+ *
+ * @param ordenados Muestras ordenadas de menor a mayor. No vacio.
+ * @param p Percentil a calcular.
+ * @return Valor del percentil.
+ */
+double percentil(std::vector<double> const &ordenados, double p);
+
+/**
+ * Resume un conjunto de tiempos: minimo, maximo, media, varianza muestral,
+ * desviacion tipica, mediana y percentiles 90 y 99.
+ *
+ * Coste: O(n logn), n = numero de muestras.
+ *
+ * @param tiempos Muestras a resumir. No vacio.
+ * @param r Resumen de las muestras.
+ */
+void resumeTiempos(std::vector<double> tiempos, ResumenTiempos &r);
+
+#endif //PROBLEMAMOCHILACPP_ESTADISTICAS_H
@@ -0,0 +1,92 @@
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+
+#include "Generador.h"
+
+/*
+ * Genera ficheros de instancias de las clases de Pisinger.
+ *
+ * Uso: GeneraCasos [-c clase] [-n objetos] [-R rango] [-f fraccionM]
+ *                  [-s semilla] [-t hilos] [-b] fichero
+ *
+ * Clases: nocorr, debil, fuerte, inversa, subconjuntos, spanner, techo.
+ * Con -b se escribe en formato binario.
+ */
+
+static const char *const NOMBRES_CLASES[] = {
+        "nocorr", "debil", "fuerte", "inversa", "subconjuntos", "spanner",
+        "techo"
+};
+
+void muestraUso() {
+    std::cout << "Uso: GeneraCasos [-c clase] [-n objetos] [-R rango] "
+                 "[-f fraccionM] [-s semilla] [-t hilos] [-b] fichero\n"
+                 "Clases:";
+    for (const char *nombre : NOMBRES_CLASES)
+        std::cout << ' ' << nombre;
+    std::cout << '\n';
+}
+
+int main(int argc, char *argv[]) {
+    ParamGenerador param;
+    std::string fichero;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-b") {
+            param.binario = true;
+        } else if (arg[0] == '-' && i + 1 < argc) {
+            std::string valor = argv[++i];
+            if (arg == "-c") {
+                bool encontrada = false;
+                for (int c = 0; c <= TECHO_BENEFICIO; ++c) {
+                    if (valor == NOMBRES_CLASES[c]) {
+                        param.clase = (ClaseInstancia) c;
+                        encontrada = true;
+                    }
+                }
+                if (!encontrada) {
+                    muestraUso();
+                    return 1;
+                }
+            } else if (arg == "-n") {
+                param.nObjetos = std::atoll(valor.c_str());
+            } else if (arg == "-R") {
+                param.R = std::atoll(valor.c_str());
+            } else if (arg == "-f") {
+                param.fraccionM = std::atof(valor.c_str());
+            } else if (arg == "-s") {
+                param.semilla = std::strtoull(valor.c_str(), nullptr, 10);
+            } else if (arg == "-t") {
+                param.nHilos = std::atoi(valor.c_str());
+            } else {
+                muestraUso();
+                return 1;
+            }
+        } else if (arg[0] != '-' && fichero.empty()) {
+            fichero = arg;
+        } else {
+            muestraUso();
+            return 1;
+        }
+    }
+    if (fichero.empty() || param.nObjetos < 0 || param.R < 1) {
+        muestraUso();
+        return 1;
+    }
+
+    auto t1 = std::chrono::steady_clock::now();
+
+    if (!generaCasoPruebaClase(fichero, param))
+        return 1;
+
+    auto t2 = std::chrono::steady_clock::now();
+    auto time_span =
+            std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
+
+    std::cout << "Generados " << param.nObjetos << " objetos en "
+              << time_span.count() << " segundos.\n";
+    return 0;
+}
@@ -0,0 +1,239 @@
+#include "Generador.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static const long long TAM_BLOQUE = 1 << 20;   //Objetos por bloque escrito
+static const int TAM_SPANNER = 2;
+static const int MULT_SPANNER = 10;
+static const long long TECHO = 3;
+
+/**
+ * Mezcla de SplitMix64: cada entrada distinta da una salida de 64 bits
+ * pseudoaleatoria e independiente de las demas.
+ */
+static unsigned long long mezcla(unsigned long long x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * Numero aleatorio uniforme en [a, b] para el contador (i, flujo).
+ */
+static long long uniforme(unsigned long long semilla, long long i, int flujo,
+                          long long a, long long b) {
+    unsigned long long x = mezcla(semilla ^ mezcla((unsigned long long) i *
+                                                   8 + flujo));
+    double u = (double) (x >> 11) * (1.0 / 9007199254740992.0); //[0, 1)
+    return a + (long long) (u * (double) (b - a + 1));
+}
+
+/**
+ * Genera un objeto de una clase que no depende de otros objetos.
+ */
+static void generaObjetoSimple(ClaseInstancia clase, long long R,
+                               unsigned long long semilla, long long i,
+                               long long &peso, long long &valor) {
+    peso = uniforme(semilla, i, 0, 1, R);
+    switch (clase) {
+        case NO_CORRELACIONADA:
+            valor = uniforme(semilla, i, 1, 1, R);
+            break;
+        case DEBILMENTE_CORRELACIONADA:
+            valor = std::max(1LL, uniforme(semilla, i, 1, peso - R / 10,
+                                           peso + R / 10));
+            break;
+        case FUERTEMENTE_CORRELACIONADA:
+        case SPANNER:
+            valor = peso + R / 10;
+            break;
+        case INVERSA_FUERTEMENTE_CORRELACIONADA:
+            valor = uniforme(semilla, i, 1, 1, R);
+            peso = valor + R / 10;
+            break;
+        case SUMA_SUBCONJUNTOS:
+            valor = peso;
+            break;
+        case TECHO_BENEFICIO:
+            valor = TECHO * ((peso + TECHO - 1) / TECHO);
+            break;
+    }
+}
+
+/**
+ * Genera el objeto i de la instancia. El resultado depende solo de los
+ * parametros y de i (generador aleatorio basado en contador), asi que es
+ * el mismo sea cual sea el numero de hilos o el orden de generacion.
+ *
+ * Coste: O(1).
+ *
+ * @param param Parametros de la instancia.
+ * @param i Indice del objeto, en [0, nObjetos).
+ * @param peso Peso del objeto.
+ * @param valor Valor del objeto.
+ */
+void generaObjeto(ParamGenerador const &param, long long i, long long &peso,
+                  long long &valor) {
+    if (param.clase != SPANNER) {
+        generaObjetoSimple(param.clase, param.R, param.semilla, i, peso,
+                           valor);
+        return;
+    }
+
+    //Elegimos un objeto del conjunto generador (que usa contadores
+    // negativos para no coincidir con ningun objeto) y un multiplicador
+    long long k = uniforme(param.semilla, i, 2, 0, TAM_SPANNER - 1);
+    long long a = uniforme(param.semilla, i, 3, 1, MULT_SPANNER);
+    long long pesoK, valorK;
+    generaObjetoSimple(SPANNER, param.R, param.semilla, -1 - k, pesoK,
+                       valorK);
+    pesoK = (2 * pesoK + MULT_SPANNER - 1) / MULT_SPANNER;
+    valorK = (2 * valorK + MULT_SPANNER - 1) / MULT_SPANNER;
+    peso = a * pesoK;
+    valor = a * valorK;
+}
+
+/**
+ * Ejecuta f(ini, fin, h) en nHilos hilos repartiendo [ini, fin) en trozos
+ * consecutivos, siendo h el numero de hilo.
+ */
+template<class F>
+static void enParalelo(long long ini, long long fin, int nHilos, F f) {
+    std::vector<std::thread> hilos;
+    long long trozo = (fin - ini + nHilos - 1) / nHilos;
+    for (int h = 0; h < nHilos; ++h) {
+        long long a = ini + h * trozo, b = std::min(fin, a + trozo);
+        if (a < b)
+            hilos.emplace_back(f, a, b, h);
+    }
+    for (std::thread &t : hilos)
+        t.join();
+}
+
+/**
+ * Formatea los objetos [a, b) en texto, una linea "peso valor" por objeto.
+ */
+static void formateaTexto(ParamGenerador const &param, long long a,
+                          long long b, std::vector<char> &buf) {
+    buf.resize((size_t) (b - a) * 42);  //Dos long long, espacio y salto
+    char *p = buf.data(), *fin = buf.data() + buf.size();
+    for (long long i = a; i < b; ++i) {
+        long long peso, valor;
+        generaObjeto(param, i, peso, valor);
+        p = std::to_chars(p, fin, peso).ptr;
+        *p++ = ' ';
+        p = std::to_chars(p, fin, valor).ptr;
+        *p++ = '\n';
+    }
+    buf.resize(p - buf.data());
+}
+
+/**
+ * Formatea los objetos [a, b) en binario, dos double (peso, valor) por
+ * objeto.
+ */
+static void formateaBinario(ParamGenerador const &param, long long a,
+                            long long b, std::vector<char> &buf) {
+    buf.resize((size_t) (b - a) * 2 * sizeof(double));
+    char *p = buf.data();
+    for (long long i = a; i < b; ++i) {
+        long long peso, valor;
+        generaObjeto(param, i, peso, valor);
+        double par[2] = {(double) peso, (double) valor};
+        std::memcpy(p, par, sizeof(par));
+        p += sizeof(par);
+    }
+}
+
+/**
+ * Genera un fichero con una instancia de la clase indicada. En formato de
+ * texto es el mismo que el de generaCasoPruebaMochilaReal, con pesos,
+ * valores y M enteros, asi que se puede leer con leeCasoPruebaMochilaReal
+ * y, si M no pasa de INT_MAX, con leeCasoPruebaMochilaInt. En formato
+ * binario se lee con leeCasoPruebaMochilaBin. Los objetos se generan y
+ * formatean en paralelo por bloques y cada bloque se escribe de una vez.
+ *
+ * Coste: O(n / h) en tiempo, n = numero de objetos, h = numero de hilos.
+ *
+ * @param nombreFichero Nombre del fichero donde guardar los datos.
+ * @param param Parametros de la instancia.
+ * @return False si no se ha podido abrir, escribir o cerrar el fichero (se
+ * muestra el error).
+ */
+bool generaCasoPruebaClase(std::string const &nombreFichero,
+                           ParamGenerador const &param) {
+    const long long n = param.nObjetos;
+    int nHilos = param.nHilos;
+    if (nHilos <= 0)
+        nHilos = std::max(1u, std::thread::hardware_concurrency());
+
+    FILE *out = std::fopen(nombreFichero.c_str(), "wb");
+    if (!out) {
+        std::cout << "ERROR. No se ha podido abrir el fichero.\n";
+        return false;
+    }
+
+    //Primera pasada: suma de los pesos para calcular M. Como los objetos
+    // dependen solo de su indice, regenerarlos despues es mas barato que
+    // guardarlos
+    std::vector<long long> sumas(nHilos, 0);
+    enParalelo(0, n, nHilos, [&](long long a, long long b, int h) {
+        long long peso, valor;
+        for (long long i = a; i < b; ++i) {
+            generaObjeto(param, i, peso, valor);
+            sumas[h] += peso;
+        }
+    });
+    long long sumaPesos = 0;
+    for (long long s : sumas)
+        sumaPesos += s;
+    const long long M = (long long) std::floor(param.fraccionM * sumaPesos);
+
+    //Cabecera
+    bool escrito;
+    if (param.binario) {
+        const char magia[8] = {'M', 'O', 'C', 'H', 'I', 'L', 'A', 'B'};
+        double MReal = (double) M;
+        escrito = std::fwrite(magia, 1, sizeof(magia), out) ==
+                  sizeof(magia) &&
+                  std::fwrite(&MReal, sizeof(MReal), 1, out) == 1 &&
+                  std::fwrite(&n, sizeof(n), 1, out) == 1;
+    } else {
+        std::string cabecera = std::to_string(M) + ' ' + std::to_string(n) +
+                               '\n';
+        escrito = std::fwrite(cabecera.data(), 1, cabecera.size(), out) ==
+                  cabecera.size();
+    }
+
+    //Segunda pasada: por bloques, cada hilo formatea su trozo del bloque en
+    // su propio buffer y despues se escriben en orden
+    std::vector<std::vector<char>> bufs(nHilos);
+    for (long long ini = 0; escrito && ini < n; ini += TAM_BLOQUE) {
+        long long fin = std::min(n, ini + TAM_BLOQUE);
+        for (std::vector<char> &buf : bufs)
+            buf.clear();
+        enParalelo(ini, fin, nHilos, [&](long long a, long long b, int h) {
+            if (param.binario)
+                formateaBinario(param, a, b, bufs[h]);
+            else
+                formateaTexto(param, a, b, bufs[h]);
+        });
+        for (std::vector<char> const &buf : bufs)
+            escrito = escrito && std::fwrite(buf.data(), 1, buf.size(),
+                                             out) == buf.size();
+    }
+
+    if (std::fclose(out) != 0)
+        escrito = false;
+    if (!escrito)
+        std::cout << "ERROR. No se ha podido escribir el fichero.\n";
+    return escrito;
+}
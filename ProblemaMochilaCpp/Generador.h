@@ -0,0 +1,70 @@
+#ifndef PROBLEMAMOCHILACPP_GENERADOR_H
+#define PROBLEMAMOCHILACPP_GENERADOR_H
+
+#include <string>
+
+/*
+ * Clases de instancias de Pisinger. Pesos en [1, R] salvo que se indique:
+ *  - NO_CORRELACIONADA: valor en [1, R].
+ *  - DEBILMENTE_CORRELACIONADA: valor en [peso - R/10, peso + R/10], >= 1.
+ *  - FUERTEMENTE_CORRELACIONADA: valor = peso + R/10.
+ *  - INVERSA_FUERTEMENTE_CORRELACIONADA: valor en [1, R], peso = valor + R/10.
+ *  - SUMA_SUBCONJUNTOS: valor = peso.
+ *  - SPANNER: 2 objetos fuertemente correlacionados reducidos a 2/10 de su
+ *    tamanyo; cada objeto es uno de ellos multiplicado por un a en [1, 10].
+ *  - TECHO_BENEFICIO: valor = 3 * techo(peso / 3).
+ */
+enum ClaseInstancia {
+    NO_CORRELACIONADA,
+    DEBILMENTE_CORRELACIONADA,
+    FUERTEMENTE_CORRELACIONADA,
+    INVERSA_FUERTEMENTE_CORRELACIONADA,
+    SUMA_SUBCONJUNTOS,
+    SPANNER,
+    TECHO_BENEFICIO
+};
+
+struct ParamGenerador {
+    ClaseInstancia clase = NO_CORRELACIONADA;
+    long long nObjetos = 1000;
+    long long R = 1000;             //Rango de los pesos y valores
+    double fraccionM = 0.5;         //M = fraccionM * suma de los pesos
+    unsigned long long semilla = 1;
+    bool binario = false;           //Formato binario o de texto
+    int nHilos = 0;                 //0 = tantos como nucleos
+};
+
+/**
+ * Genera el objeto i de la instancia. El resultado depende solo de los
+ * parametros y de i (generador aleatorio basado en contador), asi que es
+ * el mismo sea cual sea el numero de hilos o el orden de generacion.
+ *
+ * Coste: O(1).
+ *
+ * @param param Parametros de la instancia.
+ * @param i Indice del objeto, en [0, nObjetos).
+ * @param peso Peso del objeto.
+ * @param valor Valor del objeto.
+ */
+void generaObjeto(ParamGenerador const &param, long long i, long long &peso,
+                  long long &valor);
+
+/**
+ * Genera un fichero con una instancia de la clase indicada. En formato de
+ * texto es el mismo que el de generaCasoPruebaMochilaReal, con pesos,
+ * valores y M enteros, asi que se puede leer con leeCasoPruebaMochilaReal
+ * y, si M no pasa de INT_MAX, con leeCasoPruebaMochilaInt. En formato
+ * binario se lee con leeCasoPruebaMochilaBin. Los objetos se generan y
+ * formatean en paralelo por bloques y cada bloque se escribe de una vez.
+ *
+ * Coste: O(n / h) en tiempo, n = numero de objetos, h = numero de hilos.
+ *
+ * @param nombreFichero Nombre del fichero donde guardar los datos.
+ * @param param Parametros de la instancia.
+ * @return False si no se ha podido abrir, escribir o cerrar el fichero (se
+ * muestra el error).
+ */
+bool generaCasoPruebaClase(std::string const &nombreFichero,
+                           ParamGenerador const &param);
+
+#endif //PROBLEMAMOCHILACPP_GENERADOR_H
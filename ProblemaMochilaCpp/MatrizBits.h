@@ -0,0 +1,106 @@
+#ifndef PROBLEMAMOCHILACPP_MATRIZBITS_H
+#define PROBLEMAMOCHILACPP_MATRIZBITS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include "Memoria.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MATRIZ_BITS_MMAP
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#endif
+
+/*
+ * Matriz de bits empaquetada por filas (cada fila ocupa un numero entero de
+ * palabras de 64 bits) para guardar las decisiones de la programacion
+ * dinamica. Puede vivir en memoria o en un fichero temporal proyectado en
+ * memoria (mmap): asi una matriz mayor que la memoria disponible solo
+ * necesita en memoria las paginas que se estan usando, y el sistema las
+ * escribe en disco cuando hace falta. El fichero se borra al cerrarlo.
+ */
+
+class MatrizBits {
+public:
+    /**
+     * Crea la matriz con todos los bits a 0. Si enFichero es true se
+     * intenta proyectar un fichero temporal; si no se puede se avisa y se
+     * usa memoria. La matriz en memoria se anota en contador si no es
+     * nullptr (la proyectada no, la gestiona el sistema).
+     */
+    MatrizBits(size_t filas, size_t columnas, bool enFichero,
+               ContadorMemoria *contador = nullptr)
+            : palabrasFila((columnas + 63) / 64), memoria(contador) {
+        const size_t palabras = filas * palabrasFila;
+#ifdef MATRIZ_BITS_MMAP
+        if (enFichero && palabras > 0) {
+            fichero = std::tmpfile();
+            bytesProyectados = palabras * sizeof(uint64_t);
+            void *p = MAP_FAILED;
+            if (fichero &&
+                ftruncate(fileno(fichero), (off_t) bytesProyectados) == 0)
+                p = mmap(nullptr, bytesProyectados, PROT_READ | PROT_WRITE,
+                         MAP_SHARED, fileno(fichero), 0);
+            if (p != MAP_FAILED) {
+                datos = (uint64_t *) p;
+                return;
+            }
+            std::cout << "ERROR. No se ha podido proyectar el fichero de "
+                         "decisiones; se usa memoria.\n";
+            cierraFichero();
+        }
+#endif
+        memoria.assign(palabras, 0);
+        datos = memoria.data();
+    }
+
+    ~MatrizBits() {
+        cierraFichero();
+    }
+
+    MatrizBits(MatrizBits const &) = delete;
+
+    MatrizBits &operator=(MatrizBits const &) = delete;
+
+    /**
+     * Palabras de la fila i.
+     */
+    uint64_t *fila(size_t i) {
+        return datos + i * palabrasFila;
+    }
+
+    bool bit(size_t i, size_t j) const {
+        return (datos[i * palabrasFila + j / 64] >> (j % 64)) & 1;
+    }
+
+    bool enFichero() const {
+        return fichero != nullptr;
+    }
+
+private:
+    void cierraFichero() {
+#ifdef MATRIZ_BITS_MMAP
+        if (fichero) {
+            if (datos && datos != memoria.data())
+                munmap(datos, bytesProyectados);
+            std::fclose(fichero);
+            fichero = nullptr;
+            datos = nullptr;
+        }
+#endif
+    }
+
+    size_t palabrasFila;
+    uint64_t *datos = nullptr;
+    VectorContado<uint64_t> memoria;
+    std::FILE *fichero = nullptr;
+    size_t bytesProyectados = 0;
+};
+
+#endif //PROBLEMAMOCHILACPP_MATRIZBITS_H
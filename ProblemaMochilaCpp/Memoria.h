@@ -0,0 +1,124 @@
+#ifndef PROBLEMAMOCHILACPP_MEMORIA_H
+#define PROBLEMAMOCHILACPP_MEMORIA_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+/*
+ * Contabilidad de la memoria dinamica de los algoritmos. Los contenedores
+ * que crecen con la instancia (la fila y las decisiones de mochilaProgDin,
+ * los nodos, la cola y el historial de mochilaRamPoda) usan
+ * AsignadorContado, que anota cada reserva y liberacion en un
+ * ContadorMemoria: numero de reservas, bytes pedidos, bytes en uso y pico.
+ *
+ * Si el contador tiene limite, una reserva que lo superaria no se hace: se
+ * marca limiteSuperado y el asignador lanza std::bad_alloc, como cuando se
+ * acaba la memoria. Cada algoritmo decide que hacer entonces (ver su
+ * documentacion): seguir de otra forma que necesite menos memoria o parar
+ * antes, anotandolo en degradaciones, o dejar de resolver la instancia.
+ * Con un contador nullptr el asignador es el normal.
+ *
+ * Un contador no se puede usar desde varios hilos a la vez.
+ */
+
+class ContadorMemoria {
+public:
+    /**
+     * Crea un contador a 0 con el limite de bytes dado (0 = sin limite).
+     */
+    explicit ContadorMemoria(size_t limite = 0) : limite(limite) {}
+
+    /**
+     * Indica si se pueden reservar bytes mas sin superar el limite.
+     */
+    bool cabe(size_t bytes) const {
+        return limite == 0 ||
+               (bytesActuales <= limite && bytes <= limite - bytesActuales);
+    }
+
+    /**
+     * Anota una reserva. Si superaria el limite no se anota, se marca
+     * limiteSuperado y devuelve false.
+     */
+    bool reserva(size_t bytes) {
+        if (!cabe(bytes)) {
+            limiteSuperado = true;
+            return false;
+        }
+        reservas++;
+        bytesTotales += bytes;
+        bytesActuales += bytes;
+        if (bytesActuales > pico)
+            pico = bytesActuales;
+        return true;
+    }
+
+    void libera(size_t bytes) {
+        liberaciones++;
+        bytesActuales -= bytes;
+    }
+
+    /**
+     * Empieza una medida nueva: pone a 0 los contadores y el pico pasa a
+     * ser lo que sigue en uso. Mantiene el limite.
+     */
+    void reinicia() {
+        reservas = liberaciones = degradaciones = 0;
+        bytesTotales = 0;
+        pico = bytesActuales;
+        limiteSuperado = false;
+    }
+
+    size_t limite;
+    long long reservas = 0, liberaciones = 0;
+    size_t bytesTotales = 0;    //Suma de todas las reservas
+    size_t bytesActuales = 0;   //En uso
+    size_t pico = 0;            //Maximo de bytesActuales
+    bool limiteSuperado = false;
+    long long degradaciones = 0;    //Veces que se ha seguido con menos
+                                    // memoria o se ha parado antes
+};
+
+template<class T>
+class AsignadorContado {
+public:
+    typedef T value_type;
+
+    AsignadorContado(ContadorMemoria *contador = nullptr) noexcept
+            : contador(contador) {}
+
+    template<class U>
+    AsignadorContado(AsignadorContado<U> const &otro) noexcept
+            : contador(otro.contador) {}
+
+    T *allocate(size_t n) {
+        if (contador && !contador->reserva(n * sizeof(T)))
+            throw std::bad_alloc();
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T *p, size_t n) noexcept {
+        if (contador)
+            contador->libera(n * sizeof(T));
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    ContadorMemoria *contador;
+};
+
+template<class T, class U>
+bool operator==(AsignadorContado<T> const &a, AsignadorContado<U> const &b) {
+    return a.contador == b.contador;
+}
+
+template<class T, class U>
+bool operator!=(AsignadorContado<T> const &a, AsignadorContado<U> const &b) {
+    return a.contador != b.contador;
+}
+
+template<class T>
+using VectorContado = std::vector<T, AsignadorContado<T>>;
+
+#endif //PROBLEMAMOCHILACPP_MEMORIA_H
@@ -0,0 +1,173 @@
+#ifndef PROBLEMAMOCHILACPP_MOCHILAPEQUENYA_H
+#define PROBLEMAMOCHILACPP_MOCHILAPEQUENYA_H
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "Algoritmos.h"
+
+/*
+ * Ramificacion y poda para instancias pequenyas (n <= MAX_PEQUENYA) con el
+ * numero de objetos fijado en compilacion. Los objetos se guardan en
+ * std::array, la solucion parcial es una mascara de bits y la busqueda es en
+ * profundidad con un nivel por objeto, asi que no se pide memoria dinamica,
+ * no hay cola de prioridad y el compilador puede desenrollar el calculo de
+ * la cota de cada nivel. mochilaPequenya elige en tiempo de ejecucion la
+ * instancia de la plantilla que corresponde a n.
+ */
+
+static const size_t MAX_PEQUENYA = 32;
+
+template<size_t N>
+struct InstanciaPequenya {
+    std::array<double, N> peso;     //En orden decreciente de densidad
+    std::array<double, N> valor;
+    std::array<unsigned char, N> obj;   //Objeto original de cada posicion
+};
+
+/**
+ * Cota optimista (voraz fraccionada) con los objetos [K, N) y el hueco dado.
+ *
+ * Coste: O(N - K).
+ */
+template<size_t K, size_t N>
+inline double cotaPequenya(InstanciaPequenya<N> const &inst, double hueco,
+                          double valorAc) {
+    for (size_t i = K; i < N; ++i) {
+        if (inst.peso[i] <= hueco) {
+            hueco -= inst.peso[i];
+            valorAc += inst.valor[i];
+        } else {
+            return valorAc + inst.valor[i] * hueco / inst.peso[i];
+        }
+    }
+    return valorAc;
+}
+
+/**
+ * Nivel K de la busqueda en profundidad: decide el objeto K. Cada nodo es
+ * una solucion factible (los objetos que faltan sin coger), asi que se
+ * compara con la mejor antes de ramificar. Si el objeto K cabe, cogerlo no
+ * cambia la cota, asi que solo se calcula la de no cogerlo.
+ */
+template<size_t K, size_t N>
+struct ExploraPequenya {
+    static void explora(InstanciaPequenya<N> const &inst, double hueco,
+                        double valorAc, double cota,
+                        unsigned long long mascara, double &mejor,
+                        unsigned long long &mascaraMejor, long long &nodos) {
+        ++nodos;
+        if (valorAc > mejor) {
+            mejor = valorAc;
+            mascaraMejor = mascara;
+        }
+        if (cota <= mejor)
+            return;
+        if (inst.peso[K] <= hueco)
+            ExploraPequenya<K + 1, N>::explora(inst, hueco - inst.peso[K],
+                                               valorAc + inst.valor[K], cota,
+                                               mascara | 1ULL << K, mejor,
+                                               mascaraMejor, nodos);
+        ExploraPequenya<K + 1, N>::explora(
+                inst, hueco, valorAc,
+                cotaPequenya<K + 1, N>(inst, hueco, valorAc), mascara, mejor,
+                mascaraMejor, nodos);
+    }
+};
+
+template<size_t N>
+struct ExploraPequenya<N, N> {
+    static void explora(InstanciaPequenya<N> const &, double, double valorAc,
+                        double, unsigned long long mascara, double &mejor,
+                        unsigned long long &mascaraMejor, long long &nodos) {
+        ++nodos;
+        if (valorAc > mejor) {
+            mejor = valorAc;
+            mascaraMejor = mascara;
+        }
+    }
+};
+
+/**
+ * Resuelve el problema de la mochila 0-1 con exactamente N objetos.
+ *
+ * Coste: O(N 2^N) en tiempo en el peor caso y O(N) en espacio.
+ *
+ * @param objetos Conjunto de N objetos.
+ * @param M Peso maximo que soporta la mochila.
+ * @param solMejor Indica si se coge el objeto o no.
+ * @param valorMejor Valor de la mochila con los objetos dados por solMejor.
+ * @param nodosVisitados Nodos explorados.
+ */
+template<size_t N>
+void mochilaPequenyaN(std::vector<ObjetoReal> const &objetos, double M,
+                     std::vector<bool> &solMejor, double &valorMejor,
+                     long long int &nodosVisitados) {
+    InstanciaPequenya<N> inst;
+    std::array<double, N> densidad;
+
+    //Ordenacion por insercion de mayor a menor densidad
+    for (size_t i = 0; i < N; ++i) {
+        double dens = objetos[i].valor / objetos[i].peso;
+        size_t j = i;
+        for (; j > 0 && densidad[j - 1] < dens; --j) {
+            densidad[j] = densidad[j - 1];
+            inst.obj[j] = inst.obj[j - 1];
+        }
+        densidad[j] = dens;
+        inst.obj[j] = (unsigned char) i;
+    }
+    for (size_t i = 0; i < N; ++i) {
+        inst.peso[i] = objetos[inst.obj[i]].peso;
+        inst.valor[i] = objetos[inst.obj[i]].valor;
+    }
+
+    unsigned long long mascaraMejor = 0;
+    valorMejor = 0;
+    nodosVisitados = 0;
+    ExploraPequenya<0, N>::explora(inst, M, 0, cotaPequenya<0, N>(inst, M, 0),
+                                   0, valorMejor, mascaraMejor,
+                                   nodosVisitados);
+
+    for (size_t i = 0; i < N; ++i)
+        solMejor[inst.obj[i]] = (mascaraMejor >> i) & 1;
+}
+
+template<size_t... Ns>
+inline bool despachaPequenya(std::index_sequence<Ns...>,
+                            std::vector<ObjetoReal> const &objetos, double M,
+                            std::vector<bool> &solMejor, double &valorMejor,
+                            long long int &nodosVisitados) {
+    using Resolutor = void (*)(std::vector<ObjetoReal> const &, double,
+                               std::vector<bool> &, double &, long long int &);
+    static const Resolutor tabla[] = {&mochilaPequenyaN<Ns>...};
+    if (objetos.size() >= sizeof...(Ns))
+        return false;
+    tabla[objetos.size()](objetos, M, solMejor, valorMejor, nodosVisitados);
+    return true;
+}
+
+/**
+ * Resuelve el problema de la mochila 0-1 con la version de mochilaPequenyaN
+ * para el numero de objetos dado, si no pasa de MAX_PEQUENYA.
+ *
+ * Coste: O(n 2^n) en tiempo en el peor caso y O(n) en espacio, n = numero
+ * de objetos.
+ *
+ * @param objetos Conjunto de objetos que tenemos disponibles.
+ * @param M Peso maximo que soporta la mochila.
+ * @param solMejor Indica si se coge el objeto o no.
+ * @param valorMejor Valor de la mochila con los objetos dados por solMejor.
+ * @param nodosVisitados Nodos explorados.
+ * @return Falso si hay mas de MAX_PEQUENYA objetos (y no se resuelve).
+ */
+inline bool mochilaPequenya(std::vector<ObjetoReal> const &objetos, double M,
+                           std::vector<bool> &solMejor, double &valorMejor,
+                           long long int &nodosVisitados) {
+    return despachaPequenya(std::make_index_sequence<MAX_PEQUENYA + 1>(),
+                           objetos, M, solMejor, valorMejor, nodosVisitados);
+}
+
+#endif //PROBLEMAMOCHILACPP_MOCHILAPEQUENYA_H
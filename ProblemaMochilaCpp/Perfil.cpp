@@ -0,0 +1,137 @@
+#include "Perfil.h"
+
+#include <cstring>
+
+#ifdef __linux__
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#endif
+
+const char *const NOMBRES_FASES[NUM_FASES] = {
+        "ordenacion", "cotas", "cola", "tabla", "reconstruccion", "aptitud",
+        "seleccion", "cruce", "mutacion", "busqueda local"
+};
+
+#ifdef __linux__
+
+/**
+ * Abre un contador hardware del proceso actual, solo en modo usuario.
+ *
+ * @param config Evento a contar (PERF_COUNT_HW_*).
+ * @param grupo Lider del grupo o -1 si este es el lider.
+ * @return Descriptor del contador o -1 si no se ha podido abrir.
+ */
+static int abreContador(unsigned long long config, int grupo) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = grupo == -1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return (int) syscall(__NR_perf_event_open, &attr, 0, -1, grupo, 0);
+}
+
+#endif
+
+Perfil::Perfil(bool contadoresHw) : fdGrupo(-1), fdOtros{-1, -1, -1} {
+    reinicia();
+#ifdef __linux__
+    if (!contadoresHw)
+        return;
+
+    fdGrupo = abreContador(PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (fdGrupo < 0)
+        return;
+    fdOtros[0] = abreContador(PERF_COUNT_HW_INSTRUCTIONS, fdGrupo);
+    fdOtros[1] = abreContador(PERF_COUNT_HW_CACHE_MISSES, fdGrupo);
+    fdOtros[2] = abreContador(PERF_COUNT_HW_BRANCH_MISSES, fdGrupo);
+    for (int fd : fdOtros) {
+        if (fd < 0) {   //O todos o ninguno
+            cierraContadores();
+            return;
+        }
+    }
+    ioctl(fdGrupo, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fdGrupo, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#else
+    (void) contadoresHw;
+#endif
+}
+
+Perfil::~Perfil() {
+    cierraContadores();
+}
+
+/**
+ * Cierra los contadores hardware que esten abiertos.
+ */
+void Perfil::cierraContadores() {
+#ifdef __linux__
+    for (int &fd : fdOtros) {
+        if (fd >= 0)
+            close(fd);
+        fd = -1;
+    }
+    if (fdGrupo >= 0)
+        close(fdGrupo);
+    fdGrupo = -1;
+#endif
+}
+
+/**
+ * Pone a 0 todas las medidas.
+ */
+void Perfil::reinicia() {
+    nodosVisitados = 0;
+    nodosEvitados = 0;
+    std::memset(fases, 0, sizeof(fases));
+}
+
+/**
+ * Lee el valor actual de los contadores hardware (a 0 si no hay). Se leen
+ * los cuatro con una unica llamada al sistema.
+ */
+void Perfil::leeContadores(ContadoresHw &c) const {
+    std::memset(&c, 0, sizeof(c));
+#ifdef __linux__
+    if (fdGrupo < 0)
+        return;
+    unsigned long long buf[5];  //Numero de contadores y sus valores
+    if (read(fdGrupo, buf, sizeof(buf)) == (ssize_t) sizeof(buf)) {
+        c.ciclos = (long long) buf[1];
+        c.instrucciones = (long long) buf[2];
+        c.fallosCache = (long long) buf[3];
+        c.fallosSalto = (long long) buf[4];
+    }
+#endif
+}
+
+/**
+ * Muestra las fases con alguna llamada, una por linea.
+ */
+void Perfil::muestra(std::ostream &out) const {
+    if (nodosVisitados > 0)
+        out << "  nodos visitados: " << nodosVisitados << '\n';
+    if (nodosEvitados > 0)
+        out << "  nodos evitados por la cota: " << nodosEvitados << '\n';
+    for (int f = 0; f < NUM_FASES; ++f) {
+        MedidaFase const &m = fases[f];
+        if (m.llamadas == 0)
+            continue;
+        out << "  " << NOMBRES_FASES[f] << ": " << m.segundos << " s en "
+            << m.llamadas << " llamadas";
+        if (hayContadoresHw())
+            out << ", " << m.hw.ciclos << " ciclos, " << m.hw.instrucciones
+                << " instrucciones, " << m.hw.fallosCache
+                << " fallos de cache, " << m.hw.fallosSalto
+                << " fallos de salto";
+        out << '\n';
+    }
+}
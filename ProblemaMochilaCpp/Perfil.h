@@ -0,0 +1,141 @@
+#ifndef PROBLEMAMOCHILACPP_PERFIL_H
+#define PROBLEMAMOCHILACPP_PERFIL_H
+
+#include <chrono>
+#include <iostream>
+
+/*
+ * Perfilado de los algoritmos por fases. Cada algoritmo recibe un puntero
+ * opcional a un Perfil; si es nullptr no se mide nada y el coste es una
+ * comparacion por fase. Si no, cada fase acumula el numero de veces que se
+ * ha ejecutado, el tiempo y, si se han pedido y el sistema lo permite
+ * (Linux, perf_event_open), los contadores hardware del procesador.
+ *
+ * Las fases que se ejecutan una vez por nodo (cotas y cola en ramificacion
+ * y poda) anyaden varias decenas de nanosegundos por nodo al medir tiempos,
+ * y alrededor de un microsegundo mas con contadores hardware.
+ */
+
+enum Fase {
+    FASE_ORDENACION,        //Calculo y ordenacion de densidades
+    FASE_COTAS,             //Calculo de cotas (calculoEst)
+    FASE_COLA,              //Operaciones sobre la cola de prioridad
+    FASE_TABLA,             //Relleno de la tabla de programacion dinamica
+    FASE_RECONSTRUCCION,    //Reconstruccion de la solucion
+    FASE_APTITUD,           //Funcion de aptitud del genetico
+    FASE_SELECCION,         //Seleccion del genetico
+    FASE_CRUCE,             //Cruce del genetico
+    FASE_MUTACION,          //Mutacion del genetico
+    FASE_BUSQUEDA_LOCAL,    //Mejora por busqueda local
+    NUM_FASES
+};
+
+extern const char *const NOMBRES_FASES[NUM_FASES];
+
+struct ContadoresHw {
+    long long ciclos;
+    long long instrucciones;
+    long long fallosCache;
+    long long fallosSalto;
+};
+
+struct MedidaFase {
+    long long llamadas;
+    double segundos;
+    ContadoresHw hw;
+};
+
+class Perfil {
+public:
+    /**
+     * Crea un perfil vacio. Si contadoresHw es true intenta abrir los
+     * contadores hardware; si no es posible se miden solo los tiempos.
+     */
+    explicit Perfil(bool contadoresHw = false);
+
+    ~Perfil();
+
+    Perfil(Perfil const &) = delete;
+
+    Perfil &operator=(Perfil const &) = delete;
+
+    /**
+     * Pone a 0 todas las medidas.
+     */
+    void reinicia();
+
+    /**
+     * Indica si se estan leyendo los contadores hardware.
+     */
+    bool hayContadoresHw() const { return fdGrupo >= 0; }
+
+    /**
+     * Lee el valor actual de los contadores hardware (a 0 si no hay).
+     */
+    void leeContadores(ContadoresHw &c) const;
+
+    /**
+     * Muestra las fases con alguna llamada, una por linea.
+     */
+    void muestra(std::ostream &out) const;
+
+    long long nodosVisitados;
+    long long nodosEvitados;    //Podados por una cota mejor que la de Dantzig
+    MedidaFase fases[NUM_FASES];
+
+private:
+    void cierraContadores();
+
+    int fdGrupo;        //Lider del grupo de contadores (-1 si no hay)
+    int fdOtros[3];
+};
+
+/**
+ * Mide la fase mientras el objeto exista. No hace nada si perfil es nullptr.
+ */
+class MedidaAmbito {
+public:
+    MedidaAmbito(Perfil *perfil, Fase fase) : perfil(perfil), fase(fase) {
+        if (perfil) {
+            perfil->leeContadores(hwIni);
+            tIni = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~MedidaAmbito() {
+        termina();
+    }
+
+    /**
+     * Termina la medida antes de que acabe el ambito.
+     */
+    void termina() {
+        if (perfil) {
+            auto tFin = std::chrono::steady_clock::now();
+            MedidaFase &m = perfil->fases[fase];
+            m.llamadas++;
+            m.segundos += std::chrono::duration<double>(tFin - tIni).count();
+            if (perfil->hayContadoresHw()) {
+                ContadoresHw hwFin;
+                perfil->leeContadores(hwFin);
+                m.hw.ciclos += hwFin.ciclos - hwIni.ciclos;
+                m.hw.instrucciones += hwFin.instrucciones - hwIni.instrucciones;
+                m.hw.fallosCache += hwFin.fallosCache - hwIni.fallosCache;
+                m.hw.fallosSalto += hwFin.fallosSalto - hwIni.fallosSalto;
+            }
+            perfil = nullptr;
+        }
+    }
+
+    MedidaAmbito(MedidaAmbito const &) = delete;
+
+    MedidaAmbito &operator=(MedidaAmbito const &) = delete;
+
+private:
+    Perfil *perfil;
+    Fase fase;
+    std::chrono::steady_clock::time_point tIni;
+    ContadoresHw hwIni;
+};
+
+#endif //PROBLEMAMOCHILACPP_PERFIL_H
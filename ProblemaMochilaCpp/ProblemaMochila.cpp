@@ -12,6 +12,8 @@ int main() {
 
     //casoPruebaVoraz();
     //casoPruebaProgDin();
+    //casoPruebaProgDinLimite();
+    //casoPruebaProgDinDispersa();
     casoPruebaRamPoda();
     //casoPruebaGenetico();
 
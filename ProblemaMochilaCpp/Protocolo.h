@@ -0,0 +1,183 @@
+#ifndef PROBLEMAMOCHILACPP_PROTOCOLO_H
+#define PROBLEMAMOCHILACPP_PROTOCOLO_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Algoritmos.h"
+
+/*
+ * Protocolo binario entre Servidor y sus clientes por un socket local
+ * (UNIX). Como los dos extremos estan en la misma maquina, los campos van
+ * en el orden de bytes nativo y sin relleno, todos de 4 u 8 bytes.
+ *
+ * Peticion: CabeceraPeticion y despues n pares (peso, valor) de doubles.
+ * Respuesta: CabeceraRespuesta y despues ceil(n / 64) palabras de 64 bits
+ * con la solucion (el objeto i es el bit i % 64 de la palabra i / 64).
+ *
+ * Un cliente puede enviar varias peticiones sin esperar las respuestas;
+ * las respuestas pueden llegar en otro orden y se emparejan por id.
+ */
+
+static const uint32_t MAGICO_PROTOCOLO = 0x4d4f4348;    //"MOCH"
+static const uint64_t MAX_OBJETOS_PETICION = 1ULL << 26;
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+enum AlgoritmoPeticion : uint32_t {
+    PET_RAMPODA,
+    PET_DISPERSA,
+    PET_LOCAL,
+    PET_GENETICO,
+    NUM_ALGORITMOS_PETICION
+};
+
+static const char *const NOMBRES_ALGORITMOS[NUM_ALGORITMOS_PETICION] = {
+        "rampoda", "dispersa", "local", "genetico"
+};
+
+enum EstadoRespuesta : uint32_t {
+    RESP_OK,
+    RESP_ERROR      //Algoritmo desconocido o instancia no valida (M < 0,
+                    // pesos <= 0, valores < 0 o algun numero no finito)
+};
+
+struct CabeceraPeticion {
+    uint32_t magico;
+    uint32_t algoritmo;
+    uint64_t id;
+    uint64_t n;
+    double M;
+};
+
+struct CabeceraRespuesta {
+    uint32_t magico;
+    uint32_t estado;
+    uint64_t id;
+    uint64_t n;
+    double valor;
+};
+
+/**
+ * Lee exactamente bytes bytes del descriptor. Devuelve false si se cierra
+ * la conexion o hay un error.
+ */
+inline bool leeTodo(int fd, void *buf, size_t bytes) {
+    char *p = (char *) buf;
+    while (bytes > 0) {
+        ssize_t r = read(fd, p, bytes);
+        if (r <= 0)
+            return false;
+        p += r;
+        bytes -= (size_t) r;
+    }
+    return true;
+}
+
+/**
+ * Escribe exactamente bytes bytes en el descriptor. Devuelve false si hay
+ * un error.
+ */
+inline bool escribeTodo(int fd, void const *buf, size_t bytes) {
+    const char *p = (const char *) buf;
+    while (bytes > 0) {
+        ssize_t r = send(fd, p, bytes, MSG_NOSIGNAL);
+        if (r <= 0)
+            return false;
+        p += r;
+        bytes -= (size_t) r;
+    }
+    return true;
+}
+
+/**
+ * Prepara la direccion del socket. Devuelve false si la ruta es demasiado
+ * larga.
+ */
+inline bool direccionSocket(const char *ruta, sockaddr_un &dir) {
+    std::memset(&dir, 0, sizeof dir);
+    dir.sun_family = AF_UNIX;
+    if (std::strlen(ruta) >= sizeof dir.sun_path)
+        return false;
+    std::strcpy(dir.sun_path, ruta);
+    return true;
+}
+
+/**
+ * Envia una peticion en un unico mensaje.
+ */
+inline bool enviaPeticion(int fd, uint64_t id, AlgoritmoPeticion algoritmo,
+                          std::vector<ObjetoReal> const &objetos, double M) {
+    const size_t n = objetos.size();
+    std::vector<char> buf(sizeof(CabeceraPeticion) + 2 * n * sizeof(double));
+    CabeceraPeticion cab = {MAGICO_PROTOCOLO, algoritmo, id, n, M};
+    std::memcpy(buf.data(), &cab, sizeof cab);
+    double *pv = (double *) (buf.data() + sizeof cab);
+    for (size_t i = 0; i < n; ++i) {
+        pv[2 * i] = objetos[i].peso;
+        pv[2 * i + 1] = objetos[i].valor;
+    }
+    return escribeTodo(fd, buf.data(), buf.size());
+}
+
+/**
+ * Recibe una peticion. Devuelve false si se cierra la conexion o la
+ * cabecera no es valida (incluido n > MAX_OBJETOS_PETICION).
+ */
+inline bool recibePeticion(int fd, CabeceraPeticion &cab,
+                           std::vector<ObjetoReal> &objetos) {
+    if (!leeTodo(fd, &cab, sizeof cab) || cab.magico != MAGICO_PROTOCOLO ||
+        cab.n > MAX_OBJETOS_PETICION)
+        return false;
+    std::vector<double> pv(2 * cab.n);
+    if (!leeTodo(fd, pv.data(), pv.size() * sizeof(double)))
+        return false;
+    objetos.resize(cab.n);
+    for (size_t i = 0; i < cab.n; ++i)
+        objetos[i] = {pv[2 * i], pv[2 * i + 1]};
+    return true;
+}
+
+/**
+ * Envia una respuesta en un unico mensaje.
+ */
+inline bool enviaRespuesta(int fd, uint64_t id, EstadoRespuesta estado,
+                           std::vector<bool> const &solucion, double valor) {
+    const size_t n = solucion.size();
+    std::vector<uint64_t> buf(sizeof(CabeceraRespuesta) / sizeof(uint64_t) +
+                              (n + 63) / 64, 0);
+    CabeceraRespuesta cab = {MAGICO_PROTOCOLO, estado, id, n, valor};
+    std::memcpy(buf.data(), &cab, sizeof cab);
+    uint64_t *bits = buf.data() + sizeof cab / sizeof(uint64_t);
+    for (size_t i = 0; i < n; ++i)
+        if (solucion[i])
+            bits[i / 64] |= (uint64_t) 1 << (i % 64);
+    return escribeTodo(fd, buf.data(), buf.size() * sizeof(uint64_t));
+}
+
+/**
+ * Recibe una respuesta. Devuelve false si se cierra la conexion o la
+ * cabecera no es valida.
+ */
+inline bool recibeRespuesta(int fd, CabeceraRespuesta &cab,
+                            std::vector<bool> &solucion) {
+    if (!leeTodo(fd, &cab, sizeof cab) || cab.magico != MAGICO_PROTOCOLO)
+        return false;
+    std::vector<uint64_t> bits((cab.n + 63) / 64);
+    if (!leeTodo(fd, bits.data(), bits.size() * sizeof(uint64_t)))
+        return false;
+    solucion.resize(cab.n);
+    for (size_t i = 0; i < cab.n; ++i)
+        solucion[i] = (bits[i / 64] >> (i % 64)) & 1;
+    return true;
+}
+
+#endif //PROBLEMAMOCHILACPP_PROTOCOLO_H
@@ -0,0 +1,236 @@
+#include <iostream>
+#include <cmath>
+#include <condition_variable>
+#include <csignal>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Algoritmos.h"
+#include "Cache.h"
+#include "Protocolo.h"
+
+/*
+ * Servidor residente que resuelve instancias de la mochila 0-1 recibidas
+ * por un socket local (ver Protocolo.h). Asi no se paga el arranque del
+ * proceso ni la lectura de un fichero de texto por cada instancia.
+ *
+ * Uso: Servidor [-t hilos] [-k cache] socket
+ *
+ * Cada conexion tiene un hilo que lee peticiones y las deja en una cola
+ * comun. Cada hilo trabajador saca una peticion, la resuelve y envia la
+ * respuesta; las peticiones no comparten trabajo, asi que sacar varias de
+ * una vez solo haria esperar a unas detras de otras mientras los demas
+ * trabajadores estan parados. Con -k se usa una cache de soluciones
+ * (Cache.h) por algoritmo con esa capacidad, compartida por todos los
+ * trabajadores a traves de mochilaConCache.
+ */
+
+struct Conexion {
+    int fd;
+    std::mutex escritura;   //Las respuestas se escriben de una en una
+
+    explicit Conexion(int fd) : fd(fd) {}
+
+    ~Conexion() {
+        close(fd);
+    }
+};
+
+struct Peticion {
+    std::shared_ptr<Conexion> conexion;
+    CabeceraPeticion cab;
+    std::vector<ObjetoReal> objetos;
+};
+
+struct ColaPeticiones {
+    std::mutex mutex;
+    std::condition_variable hayPeticiones;
+    std::deque<Peticion> pendientes;
+};
+
+struct EstadoServidor {
+    ColaPeticiones cola;
+    std::vector<std::unique_ptr<CacheSoluciones>> caches;  //Por algoritmo
+};
+
+void muestraUso() {
+    std::cout << "Uso: Servidor [-t hilos] [-k cache] socket\n";
+}
+
+/**
+ * Indica si la instancia se puede pasar a los algoritmos: M finito y >= 0,
+ * pesos finitos y > 0 (se divide por ellos al calcular densidades) y
+ * valores finitos y >= 0.
+ */
+bool instanciaValida(std::vector<ObjetoReal> const &objetos, double M) {
+    if (!std::isfinite(M) || M < 0)
+        return false;
+    for (ObjetoReal const &o : objetos)
+        if (!std::isfinite(o.peso) || o.peso <= 0 ||
+            !std::isfinite(o.valor) || o.valor < 0)
+            return false;
+    return true;
+}
+
+/**
+ * Resuelve la instancia con el algoritmo pedido.
+ *
+ * @return false si el algoritmo no existe.
+ */
+bool resuelve(uint32_t algoritmo, std::vector<ObjetoReal> const &objetos,
+              double M, std::vector<bool> &sol, double &valor) {
+    sol.assign(objetos.size(), false);
+    valor = 0;
+    switch (algoritmo) {
+        case PET_RAMPODA: {
+            long long int nodos;
+            mochilaRamPoda(objetos, M, sol, valor, nodos);
+            return true;
+        }
+        case PET_DISPERSA:
+            mochilaProgDinDispersa(objetos, M, sol, valor);
+            return true;
+        case PET_LOCAL:
+            mochilaBusquedaLocal(objetos, M, sol, valor);
+            return true;
+        case PET_GENETICO:
+            mochilaGenetico(objetos, M, sol, valor);
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Resuelve la peticion, usando la cache si la hay, y envia la respuesta.
+ */
+void atiende(EstadoServidor &est, Peticion const &pet) {
+    std::vector<bool> sol;
+    double valor = 0;
+    bool valida = pet.cab.algoritmo < NUM_ALGORITMOS_PETICION &&
+                  instanciaValida(pet.objetos, pet.cab.M);
+    if (valida && pet.objetos.empty()) {
+        //Sin objetos la mochila vacia es la solucion; no se llama a nadie
+    } else if (valida && !est.caches.empty()) {
+        //Cada algoritmo tiene su cache, con su capacidad; la clave lleva
+        // ademas el algoritmo
+        const uint32_t algoritmo = pet.cab.algoritmo;
+        mochilaConCache(*est.caches[algoritmo], pet.objetos, pet.cab.M, sol,
+                        valor, [&](std::vector<ObjetoReal> const &objetos,
+                                   double M, std::vector<bool> &solucion,
+                                   double &valorSol) {
+            resuelve(algoritmo, objetos, M, solucion, valorSol);
+        }, idResolutor(NOMBRES_ALGORITMOS[algoritmo]));
+    } else if (valida) {
+        resuelve(pet.cab.algoritmo, pet.objetos, pet.cab.M, sol, valor);
+    } else {
+        sol.assign(pet.objetos.size(), false);
+    }
+
+    std::lock_guard<std::mutex> cerrojo(pet.conexion->escritura);
+    enviaRespuesta(pet.conexion->fd, pet.cab.id, valida ? RESP_OK : RESP_ERROR,
+                   sol, valor);
+}
+
+/**
+ * Hilo trabajador: saca las peticiones de la cola de una en una y las
+ * atiende.
+ */
+void trabajador(EstadoServidor &est) {
+    while (true) {
+        Peticion pet;
+        {
+            std::unique_lock<std::mutex> cerrojo(est.cola.mutex);
+            est.cola.hayPeticiones.wait(cerrojo, [&]() {
+                return !est.cola.pendientes.empty();
+            });
+            pet = std::move(est.cola.pendientes.front());
+            est.cola.pendientes.pop_front();
+        }
+        atiende(est, pet);
+    }
+}
+
+/**
+ * Hilo lector de una conexion: encola sus peticiones hasta que se cierra.
+ */
+void lector(EstadoServidor &est, std::shared_ptr<Conexion> conexion) {
+    while (true) {
+        Peticion pet;
+        pet.conexion = conexion;
+        if (!recibePeticion(conexion->fd, pet.cab, pet.objetos))
+            break;
+        {
+            std::lock_guard<std::mutex> cerrojo(est.cola.mutex);
+            est.cola.pendientes.push_back(std::move(pet));
+        }
+        est.cola.hayPeticiones.notify_one();
+    }
+    shutdown(conexion->fd, SHUT_RD);
+}
+
+int main(int argc, char *argv[]) {
+    EstadoServidor est;
+    int nHilos = 0;
+    size_t capacidadCache = 0;
+    std::string ruta;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg[0] == '-' && i + 1 < argc) {
+            std::string valor = argv[++i];
+            if (arg == "-t") {
+                nHilos = std::atoi(valor.c_str());
+            } else if (arg == "-k") {
+                capacidadCache = (size_t) std::atoll(valor.c_str());
+            } else {
+                muestraUso();
+                return 1;
+            }
+        } else if (arg[0] != '-' && ruta.empty()) {
+            ruta = arg;
+        } else {
+            muestraUso();
+            return 1;
+        }
+    }
+    sockaddr_un dir;
+    if (ruta.empty() || !direccionSocket(ruta.c_str(), dir)) {
+        muestraUso();
+        return 1;
+    }
+    if (nHilos <= 0)
+        nHilos = (int) std::max(1u, std::thread::hardware_concurrency());
+    for (size_t a = 0; capacidadCache > 0 && a < NUM_ALGORITMOS_PETICION; ++a)
+        est.caches.emplace_back(new CacheSoluciones(capacidadCache));
+
+    //Un cliente que se va sin leer sus respuestas no debe tirar el servidor
+    std::signal(SIGPIPE, SIG_IGN);
+
+    int fdEscucha = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(ruta.c_str());
+    if (fdEscucha < 0 || bind(fdEscucha, (sockaddr *) &dir, sizeof dir) != 0 ||
+        listen(fdEscucha, 128) != 0) {
+        std::cout << "ERROR. No se ha podido crear el socket " << ruta << '\n';
+        return 1;
+    }
+
+    std::vector<std::thread> trabajadores;
+    for (int h = 0; h < nHilos; ++h)
+        trabajadores.emplace_back(trabajador, std::ref(est));
+    std::cout << "Escuchando en " << ruta << " con " << nHilos
+              << " hilos.\n" << std::flush;
+
+    while (true) {
+        int fd = accept(fdEscucha, nullptr, nullptr);
+        if (fd < 0)
+            continue;
+        std::thread(lector, std::ref(est),
+                    std::make_shared<Conexion>(fd)).detach();
+    }
+}
@@ -0,0 +1,205 @@
+#include "Solucion.h"
+
+#include <charconv>
+#include <iostream>
+
+static const size_t TAM_BUFFER = (size_t) 1 << 16;
+static const size_t MAX_CAMPO = 64;     //Caracteres de un numero y separador
+
+/**
+ * Pasa una solucion 0-1 densa a dispersa.
+ *
+ * Coste: O(n), n = numero de objetos.
+ *
+ * @param densa Indica si se coge el objeto o no.
+ * @param sol Solucion dispersa.
+ */
+void solucionDispersa(std::vector<bool> const &densa, SolucionDispersa &sol) {
+    sol.n = densa.size();
+    sol.cogidos.clear();
+    sol.hayFraccion = false;
+    sol.objFraccion = 0;
+    sol.fraccion = 0;
+    for (size_t i = 0; i < densa.size(); ++i)
+        if (densa[i])
+            sol.cogidos.push_back(i);
+}
+
+/**
+ * Pasa una solucion fraccionaria densa (cuanto se coge de cada objeto, en
+ * [0, 1]) a dispersa. Si hay mas de un objeto partido muestra un error y
+ * devuelve false.
+ *
+ * Coste: O(n), n = numero de objetos.
+ *
+ * @param densa Indica cuanto se coge de cada objeto [0, 1].
+ * @param sol Solucion dispersa.
+ * @return False si hay mas de un objeto partido.
+ */
+bool solucionDispersa(std::vector<double> const &densa,
+                      SolucionDispersa &sol) {
+    sol.n = densa.size();
+    sol.cogidos.clear();
+    sol.hayFraccion = false;
+    sol.objFraccion = 0;
+    sol.fraccion = 0;
+    for (size_t i = 0; i < densa.size(); ++i) {
+        if (densa[i] >= 1) {
+            sol.cogidos.push_back(i);
+        } else if (densa[i] > 0) {
+            if (sol.hayFraccion) {
+                std::cout << "ERROR. La solucion tiene mas de un objeto "
+                             "partido.\n";
+                return false;
+            }
+            sol.hayFraccion = true;
+            sol.objFraccion = i;
+            sol.fraccion = densa[i];
+        }
+    }
+    return true;
+}
+
+/**
+ * Pasa una solucion dispersa a 0-1 densa. El objeto partido, si lo hay, no
+ * se coge.
+ *
+ * Coste: O(n), n = numero de objetos.
+ *
+ * @param sol Solucion dispersa.
+ * @param densa Indica si se coge el objeto o no.
+ */
+void solucionDensa(SolucionDispersa const &sol, std::vector<bool> &densa) {
+    densa.assign(sol.n, false);
+    for (size_t i : sol.cogidos)
+        densa[i] = true;
+}
+
+/**
+ * Pasa una solucion dispersa a fraccionaria densa.
+ *
+ * Coste: O(n), n = numero de objetos.
+ *
+ * @param sol Solucion dispersa.
+ * @param densa Indica cuanto se coge de cada objeto [0, 1].
+ */
+void solucionDensa(SolucionDispersa const &sol, std::vector<double> &densa) {
+    densa.assign(sol.n, 0);
+    for (size_t i : sol.cogidos)
+        densa[i] = 1;
+    if (sol.hayFraccion)
+        densa[sol.objFraccion] = sol.fraccion;
+}
+
+EscritorSoluciones::~EscritorSoluciones() {
+    cierra();
+}
+
+bool EscritorSoluciones::abre(std::string const &fichero) {
+    cierra();
+    out = std::fopen(fichero.c_str(), "wb");
+    if (!out) {
+        std::cout << "ERROR. No se ha podido abrir el fichero " << fichero
+                  << '\n';
+        return false;
+    }
+    buf.resize(TAM_BUFFER);
+    usado = 0;
+    error = false;
+    return true;
+}
+
+void EscritorSoluciones::escribe(SolucionDispersa const &sol,
+                                 double valorSol) {
+    if (!out)
+        return;
+    cabecera(sol.n, valorSol, sol.cogidos.size());
+    if (sol.hayFraccion) {
+        caracter(' ');
+        indice(sol.objFraccion);
+        if (buf.size() - usado < MAX_CAMPO)
+            vacia();
+        usado += std::snprintf(buf.data() + usado, MAX_CAMPO, " %.17g",
+                               sol.fraccion);
+    }
+    caracter('\n');
+    for (size_t j = 0; j < sol.cogidos.size(); ++j) {
+        if (j > 0)
+            caracter(' ');
+        indice(sol.cogidos[j]);
+    }
+    caracter('\n');
+}
+
+void EscritorSoluciones::escribe(std::vector<bool> const &solucion,
+                                 double valorSol) {
+    if (!out)
+        return;
+    size_t k = 0;
+    for (bool b : solucion)
+        k += b;
+    cabecera(solucion.size(), valorSol, k);
+    caracter('\n');
+    bool primero = true;
+    for (size_t i = 0; i < solucion.size(); ++i) {
+        if (solucion[i]) {
+            if (!primero)
+                caracter(' ');
+            indice(i);
+            primero = false;
+        }
+    }
+    caracter('\n');
+}
+
+bool EscritorSoluciones::cierra() {
+    if (out) {
+        vacia();
+        if (std::fclose(out) != 0 && !error) {
+            std::cout << "ERROR. No se ha podido escribir el fichero.\n";
+            error = true;
+        }
+        out = nullptr;
+    }
+    return !error;
+}
+
+/**
+ * Escribe "n valorSol k" sin el salto de linea.
+ */
+void EscritorSoluciones::cabecera(size_t n, double valorSol, size_t k) {
+    indice(n);
+    if (buf.size() - usado < MAX_CAMPO)
+        vacia();
+    usado += std::snprintf(buf.data() + usado, MAX_CAMPO, " %.17g ",
+                           valorSol);
+    indice(k);
+}
+
+/**
+ * Escribe el numero, sin separadores.
+ */
+void EscritorSoluciones::indice(size_t i) {
+    if (buf.size() - usado < MAX_CAMPO)
+        vacia();
+    usado = std::to_chars(buf.data() + usado, buf.data() + buf.size(),
+                          i).ptr - buf.data();
+}
+
+void EscritorSoluciones::caracter(char c) {
+    if (usado == buf.size())
+        vacia();
+    buf[usado++] = c;
+}
+
+/**
+ * Vuelca el buffer al fichero. Si no se puede, muestra un error (solo la
+ * primera vez) y lo que queda por escribir se descarta.
+ */
+void EscritorSoluciones::vacia() {
+    if (!error && std::fwrite(buf.data(), 1, usado, out) != usado) {
+        std::cout << "ERROR. No se ha podido escribir el fichero.\n";
+        error = true;
+    }
+    usado = 0;
+}
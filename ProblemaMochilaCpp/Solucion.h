@@ -0,0 +1,130 @@
+#ifndef PROBLEMAMOCHILACPP_SOLUCION_H
+#define PROBLEMAMOCHILACPP_SOLUCION_H
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/*
+ * Solucion dispersa de la mochila: los indices de los objetos que se cogen
+ * enteros, ordenados, y como mucho un objeto del que se coge una parte
+ * (el que parte mochilaVoraz). Cuando se cogen pocos objetos ocupa mucho
+ * menos que el vector denso de n posiciones y no hay que ponerlo a cero.
+ *
+ * EscritorSoluciones las escribe en un fichero de texto una detras de
+ * otra, por un buffer, sin construir la salida completa en memoria.
+ */
+
+struct SolucionDispersa {
+    size_t n = 0;                   //Numero de objetos de la instancia
+    std::vector<size_t> cogidos;    //Objetos cogidos enteros, ordenados
+    bool hayFraccion = false;       //Si se coge parte de un objeto mas
+    size_t objFraccion = 0;
+    double fraccion = 0;            //Parte que se coge de objFraccion (0, 1)
+};
+
+/**
+ * Pasa una solucion 0-1 densa a dispersa.
+ *
+ * Coste: O(n), n = numero de objetos.
+ *
+ * @param densa Indica si se coge el objeto o no.
+ * @param sol Solucion dispersa.
+ */
+void solucionDispersa(std::vector<bool> const &densa, SolucionDispersa &sol);
+
+/**
+ * Pasa una solucion fraccionaria densa (cuanto se coge de cada objeto, en
+ * [0, 1]) a dispersa. Si hay mas de un objeto partido muestra un error y
+ * devuelve false.
+ *
+ * Coste: O(n), n = numero de objetos.
+ *
+ * @param densa Indica cuanto se coge de cada objeto [0, 1].
+ * @param sol Solucion dispersa.
+ * @return False si hay mas de un objeto partido.
+ */
+bool solucionDispersa(std::vector<double> const &densa,
+                      SolucionDispersa &sol);
+
+/**
+ * Pasa una solucion dispersa a 0-1 densa. El objeto partido, si lo hay, no
+ * se coge.
+ *
+ * Coste: O(n), n = numero de objetos.
+ *
+ * @param sol Solucion dispersa.
+ * @param densa Indica si se coge el objeto o no.
+ */
+void solucionDensa(SolucionDispersa const &sol, std::vector<bool> &densa);
+
+/**
+ * Pasa una solucion dispersa a fraccionaria densa.
+ *
+ * Coste: O(n), n = numero de objetos.
+ *
+ * @param sol Solucion dispersa.
+ * @param densa Indica cuanto se coge de cada objeto [0, 1].
+ */
+void solucionDensa(SolucionDispersa const &sol, std::vector<double> &densa);
+
+/**
+ * Escribe soluciones en un fichero de texto, cada una en dos lineas:
+ *
+ *   n valorSol k [objFraccion fraccion]
+ *   i1 i2 ... ik
+ *
+ * con los k objetos cogidos enteros en orden. La salida pasa por un buffer
+ * de tamanyo fijo que se vuelca al fichero cuando se llena.
+ */
+class EscritorSoluciones {
+public:
+    EscritorSoluciones() = default;
+
+    ~EscritorSoluciones();
+
+    EscritorSoluciones(EscritorSoluciones const &) = delete;
+
+    EscritorSoluciones &operator=(EscritorSoluciones const &) = delete;
+
+    /**
+     * Crea el fichero. Si no se puede, muestra un error y devuelve false.
+     */
+    bool abre(std::string const &fichero);
+
+    bool abierto() const { return out != nullptr; }
+
+    /**
+     * Escribe la solucion. Coste: O(k), k = objetos cogidos.
+     */
+    void escribe(SolucionDispersa const &sol, double valorSol);
+
+    /**
+     * Escribe una solucion 0-1 densa sin pasarla antes a dispersa.
+     * Coste: O(n).
+     */
+    void escribe(std::vector<bool> const &solucion, double valorSol);
+
+    /**
+     * Vuelca el buffer y cierra el fichero. Devuelve false si alguna
+     * escritura o el cierre han fallado (ya se ha mostrado el error).
+     */
+    bool cierra();
+
+private:
+    void cabecera(size_t n, double valorSol, size_t k);
+
+    void indice(size_t i);
+
+    void caracter(char c);
+
+    void vacia();
+
+    std::FILE *out = nullptr;
+    std::vector<char> buf;
+    size_t usado = 0;
+    bool error = false;     //Si ha fallado una escritura
+};
+
+#endif //PROBLEMAMOCHILACPP_SOLUCION_H